@@ -1,4 +1,4 @@
-use std::collections::HashMap;
+use std::{collections::HashMap, sync::OnceLock};
 
 use serde::Deserialize;
 use serde_with::{
@@ -27,6 +27,33 @@ pub struct Config {
   pub manifest:       Manifest,
   #[serde(skip)]
   pub session_id:     String,
+  /// Target URL parsed once on first use and shared by `target_host`,
+  /// `target_port`, and `target_is_https`
+  #[serde(skip)]
+  parsed_target_url:  OnceLock<Url>,
+}
+
+/// One request in a `--batch` corpus: only the fields a proof needs. The
+/// notary connection settings always come from the client's own [`Config`],
+/// so corpus lines carry no connection boilerplate.
+#[derive(Deserialize, Clone, Debug)]
+pub struct BatchEntry {
+  pub manifest:    Manifest,
+  #[serde(default)]
+  pub target_body: String,
+  #[serde(default)]
+  pub session_id:  String,
+}
+
+impl BatchEntry {
+  /// Assigns a fresh session ID when the entry does not carry one, returning
+  /// the resulting ID.
+  pub fn set_session_id(&mut self) -> String {
+    if self.session_id.is_empty() {
+      self.session_id = uuid::Uuid::new_v4().to_string();
+    }
+    self.session_id.clone()
+  }
 }
 
 impl Config {
@@ -55,7 +82,7 @@ impl Config {
   /// # Errors
   /// - Returns `ClientErrors::Other` if the host is not found in the target URL.
   pub fn target_host(&self) -> Result<String, WebProverClientError> {
-    let target_url = Url::parse(&self.manifest.request.url)?;
+    let target_url = self.target_url_parsed()?;
     let host = target_url
       .host_str()
       .ok_or_else(|| WebProverClientError::Other("Host not found in target URL".to_owned()))?
@@ -76,7 +103,7 @@ impl Config {
   /// # Errors
   /// - Returns `ClientErrors::Other` if the port is not found in the target URL.
   pub fn target_port(&self) -> Result<u16, WebProverClientError> {
-    let target_url = Url::parse(&self.manifest.request.url)?;
+    let target_url = self.target_url_parsed()?;
     let port = target_url
       .port_or_known_default()
       .ok_or_else(|| WebProverClientError::Other("Port not found in target URL".to_owned()))?;
@@ -94,7 +121,17 @@ impl Config {
   /// # Errors
   /// - Returns `ClientErrors::Other` if the URL is invalid.
   pub fn target_is_https(&self) -> Result<bool, WebProverClientError> {
-    let target_url = Url::parse(&self.manifest.request.url)?;
+    let target_url = self.target_url_parsed()?;
     Ok(target_url.scheme() == "https")
   }
+
+  /// Returns the parsed target URL, parsing `manifest.request.url` once and
+  /// reusing the result for every later call.
+  fn target_url_parsed(&self) -> Result<&Url, WebProverClientError> {
+    if let Some(url) = self.parsed_target_url.get() {
+      return Ok(url);
+    }
+    let url = Url::parse(&self.manifest.request.url)?;
+    Ok(self.parsed_target_url.get_or_init(|| url))
+  }
 }
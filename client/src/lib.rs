@@ -21,64 +21,106 @@ pub struct ProxyConfig {
   pub manifest:       Manifest,
 }
 
-pub async fn proxy(config: config::Config) -> Result<TeeProof, WebProverClientError> {
-  let session_id = config.session_id.clone();
-
-  let url = format!(
-    "https://{}:{}/v1/proxy?session_id={}",
-    config.notary_host.clone(),
-    config.notary_port.clone(),
-    session_id.clone(),
-  );
-
-  let proxy_config = ProxyConfig {
-    target_method:  config.manifest.request.method.clone(),
-    target_url:     config.manifest.request.url.clone(),
-    target_headers: config.manifest.request.headers.clone(),
-    target_body:    config.target_body,
-    manifest:       config.manifest,
-  };
-
-  let client = {
+/// A persistent handle to a notary.
+///
+/// Constructed once from a [`config::Config`], it owns the underlying
+/// `reqwest::Client` (including the parsed notary CA certificate), so repeat
+/// `proxy`/`verify` calls reuse the warm notary connection instead of paying
+/// client construction plus a cold TLS handshake per proof.
+pub struct WebProverClient {
+  config: config::Config,
+  client: reqwest::Client,
+}
+
+impl WebProverClient {
+  pub fn new(config: config::Config) -> Result<Self, WebProverClientError> {
     let mut client_builder = reqwest::ClientBuilder::new().use_rustls_tls();
-    if let Some(cert) = config.notary_ca_cert {
+    if let Some(cert) = &config.notary_ca_cert {
       client_builder =
-        client_builder.add_root_certificate(reqwest::tls::Certificate::from_der(&cert)?);
+        client_builder.add_root_certificate(reqwest::tls::Certificate::from_der(cert)?);
     }
-    client_builder.build()?
-  };
+    Ok(Self { client: client_builder.build()?, config })
+  }
+
+  pub fn config(&self) -> &config::Config { &self.config }
+
+  pub async fn proxy(&self) -> Result<TeeProof, WebProverClientError> {
+    self
+      .proxy_request(&self.config.manifest, &self.config.target_body, &self.config.session_id)
+      .await
+  }
+
+  /// Requests one proof for a batch entry over this client's warm notary
+  /// connection. The notary endpoint comes from the client's own config; the
+  /// manifest, body, and session ID come from the entry, so a batch corpus
+  /// shares one connection pool without repeating connection settings.
+  pub async fn proxy_with(
+    &self,
+    entry: &config::BatchEntry,
+  ) -> Result<TeeProof, WebProverClientError> {
+    self.proxy_request(&entry.manifest, &entry.target_body, &entry.session_id).await
+  }
+
+  async fn proxy_request(
+    &self,
+    manifest: &Manifest,
+    target_body: &str,
+    session_id: &str,
+  ) -> Result<TeeProof, WebProverClientError> {
+    let url = format!(
+      "https://{}:{}/v1/proxy?session_id={}",
+      self.config.notary_host, self.config.notary_port, session_id,
+    );
+
+    let proxy_config = ProxyConfig {
+      target_method:  manifest.request.method.clone(),
+      target_url:     manifest.request.url.clone(),
+      target_headers: manifest.request.headers.clone(),
+      target_body:    target_body.to_string(),
+      manifest:       manifest.clone(),
+    };
+
+    let response = self.client.post(url).json(&proxy_config).send().await?;
+    if response.status() != hyper::StatusCode::OK {
+      return Err(WebProverClientError::Other(format!(
+        "notary returned {} for session {}",
+        response.status(),
+        session_id
+      )));
+    }
+    let tee_proof = response.json::<TeeProof>().await?;
+    Ok(tee_proof)
+  }
+
+  pub async fn verify<T: Serialize>(
+    &self,
+    verify_body: T,
+  ) -> Result<SignedVerificationReply, WebProverClientError> {
+    let url = format!(
+      "https://{}:{}/v1/{}/verify",
+      self.config.notary_host, self.config.notary_port, "tee",
+    );
 
-  let response = client.post(url).json(&proxy_config).send().await?;
-  assert_eq!(response.status(), hyper::StatusCode::OK);
-  let tee_proof = response.json::<TeeProof>().await?;
-  Ok(tee_proof)
+    let response = self.client.post(url).json(&verify_body).send().await?;
+    assert!(response.status() == hyper::StatusCode::OK, "response={:?}", response);
+    let verify_response = response.json::<SignedVerificationReply>().await?;
+
+    debug!("\n{:?}\n\n", verify_response.clone());
+
+    Ok(verify_response)
+  }
+}
+
+/// One-shot variant of [`WebProverClient::proxy`] for callers that only need
+/// a single proof; loops should construct a [`WebProverClient`] instead.
+pub async fn proxy(config: config::Config) -> Result<TeeProof, WebProverClientError> {
+  WebProverClient::new(config)?.proxy().await
 }
 
+/// One-shot variant of [`WebProverClient::verify`]; see [`proxy`].
 pub async fn verify<T: Serialize>(
   config: crate::config::Config,
   verify_body: T,
 ) -> Result<SignedVerificationReply, error::WebProverClientError> {
-  let url = format!(
-    "https://{}:{}/v1/{}/verify",
-    config.notary_host.clone(),
-    config.notary_port.clone(),
-    "tee",
-  );
-
-  let client = {
-    let mut client_builder = reqwest::ClientBuilder::new().use_rustls_tls();
-    if let Some(cert) = config.notary_ca_cert {
-      client_builder =
-        client_builder.add_root_certificate(reqwest::tls::Certificate::from_der(&cert)?);
-    }
-    client_builder.build()?
-  };
-
-  let response = client.post(url).json(&verify_body).send().await?;
-  assert!(response.status() == hyper::StatusCode::OK, "response={:?}", response);
-  let verify_response = response.json::<SignedVerificationReply>().await?;
-
-  debug!("\n{:?}\n\n", verify_response.clone());
-
-  Ok(verify_response)
+  WebProverClient::new(config)?.verify(verify_body).await
 }
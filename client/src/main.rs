@@ -1,6 +1,18 @@
+use std::{io::Write, time::Instant};
+
 use clap::Parser;
-use tracing::Level;
-use web_prover_client::{config::Config, error::WebProverClientError};
+use futures::StreamExt;
+use serde_json::json;
+use tokio::io::AsyncBufReadExt;
+use tracing::{info, warn, Level};
+use web_prover_client::{
+  config::{BatchEntry, Config},
+  error::WebProverClientError,
+  WebProverClient,
+};
+
+/// How many completed proofs between progress reports in batch mode
+const BATCH_PROGRESS_INTERVAL: usize = 100;
 
 #[derive(Parser)]
 #[clap(name = "Web Proof Client")]
@@ -11,6 +23,20 @@ struct Args {
 
   #[clap(short, long, required = true, default_value = "config.json")]
   config: String,
+
+  /// JSONL file with one batch entry (manifest, optional target_body and
+  /// session_id) per line; enables batch mode, where the notary connection
+  /// settings come from `--config`
+  #[clap(long)]
+  batch: Option<String>,
+
+  /// Maximum number of notarizations in flight at once in batch mode
+  #[clap(long, default_value_t = 16)]
+  concurrency: usize,
+
+  /// Where batch mode writes proofs as JSONL; "-" for stdout
+  #[clap(short, long, default_value = "-")]
+  output: String,
 }
 
 #[tokio::main]
@@ -25,15 +51,107 @@ async fn main() -> Result<(), WebProverClientError> {
     "trace" => Level::TRACE,
     _ => Level::TRACE,
   };
-  tracing_subscriber::fmt().with_max_level(log_level).with_line_number(true).init();
+  // Logs go to stderr so batch proof output can stream to stdout
+  tracing_subscriber::fmt()
+    .with_max_level(log_level)
+    .with_line_number(true)
+    .with_writer(std::io::stderr)
+    .init();
 
   let _ = rustls::crypto::ring::default_provider().install_default();
   let config_json = std::fs::read_to_string(args.config)?;
   let mut config: Config = serde_json::from_str(&config_json)?;
   config.set_session_id();
 
+  if let Some(batch_path) = args.batch {
+    let client = WebProverClient::new(config)?;
+    return run_batch(&client, &batch_path, args.concurrency.max(1), &args.output).await;
+  }
+
   let proof = web_prover_client::proxy(config).await?;
   let proof_json = serde_json::to_string_pretty(&proof)?;
   println!("Proving Successful: proof_len={:?}", proof_json.len());
   Ok(())
 }
+
+/// Streams request entries from `batch_path` and drives up to `concurrency`
+/// notarizations at a time over the shared `client`, writing one JSON line per
+/// completed entry (proof or error, tagged with the input line index) as it
+/// finishes. Entries complete out of order; the line index correlates them
+/// back to the corpus.
+async fn run_batch(
+  client: &WebProverClient,
+  batch_path: &str,
+  concurrency: usize,
+  output: &str,
+) -> Result<(), WebProverClientError> {
+  let file = tokio::fs::File::open(batch_path).await?;
+  let lines = tokio::io::BufReader::new(file).lines();
+
+  // Lazily yield (line index, line) pairs so the corpus never has to fit in
+  // memory; buffer_unordered below bounds how many are in flight
+  let entries = futures::stream::unfold((lines, 0usize), |(mut lines, index)| async move {
+    match lines.next_line().await {
+      Ok(Some(line)) => Some(((index, line), (lines, index + 1))),
+      Ok(None) => None,
+      Err(err) => {
+        warn!("stopping batch: failed to read entry {}: {}", index, err);
+        None
+      },
+    }
+  });
+
+  let mut out: Box<dyn Write> = if output == "-" {
+    Box::new(std::io::stdout().lock())
+  } else {
+    Box::new(std::io::BufWriter::new(std::fs::File::create(output)?))
+  };
+
+  let started = Instant::now();
+  let mut completed = 0usize;
+  let mut failures = 0usize;
+
+  let results = entries
+    .filter(|(_, line)| futures::future::ready(!line.trim().is_empty()))
+    .map(|(index, line)| async move {
+      let outcome = async {
+        let mut entry: BatchEntry = serde_json::from_str(&line)?;
+        entry.set_session_id();
+        client.proxy_with(&entry).await
+      }
+      .await;
+      (index, outcome)
+    })
+    .buffer_unordered(concurrency);
+  futures::pin_mut!(results);
+
+  while let Some((index, outcome)) = results.next().await {
+    match outcome {
+      Ok(proof) => writeln!(out, "{}", json!({ "index": index, "proof": proof }))?,
+      Err(err) => {
+        failures += 1;
+        writeln!(out, "{}", json!({ "index": index, "error": err.to_string() }))?;
+      },
+    }
+    completed += 1;
+    if completed % BATCH_PROGRESS_INTERVAL == 0 {
+      info!(
+        "completed {} entries ({} failures, {:.1} proofs/s)",
+        completed,
+        failures,
+        completed as f64 / started.elapsed().as_secs_f64()
+      );
+    }
+  }
+  out.flush()?;
+
+  let elapsed = started.elapsed().as_secs_f64();
+  info!(
+    "batch complete: {} entries, {} failures in {:.1}s ({:.1} proofs/s)",
+    completed,
+    failures,
+    elapsed,
+    completed as f64 / elapsed.max(f64::EPSILON)
+  );
+  Ok(())
+}
@@ -0,0 +1,265 @@
+//! Benchmarks for the extraction, predicate, and digest hot paths.
+//!
+//! Run with `cargo bench -p web-prover-core`. Extraction benchmarks report
+//! throughput in bytes/sec over bodies from ~1 KB to ~20 MB so regressions in
+//! parser cost-per-byte show up directly.
+
+use std::hint::black_box;
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use serde_json::{json, Value};
+use web_prover_core::{
+  http::NotaryResponse,
+  manifest::Manifest,
+  parser::{validate_predicate, ExtractorConfig, Predicate},
+  test_utils::TEST_MANIFEST,
+};
+
+/// Approximate body sizes the extraction benchmarks sweep over, in bytes
+const BODY_SIZES: &[(&str, usize)] =
+  &[("1KB", 1 << 10), ("64KB", 64 << 10), ("1MB", 1 << 20), ("20MB", 20 << 20)];
+
+fn parse_config(value: Value) -> ExtractorConfig { serde_json::from_value(value).unwrap() }
+
+/// Builds a JSON body of roughly `target_bytes` with a fixed `user` record and
+/// a padding array carrying the bulk, plus a config extracting from the record
+fn synth_json(target_bytes: usize) -> (Vec<u8>, ExtractorConfig) {
+  let padding_entry = "x".repeat(64);
+  let entries = target_bytes / (padding_entry.len() + 3);
+  let body = json!({
+    "user": {
+      "name": "John Doe",
+      "age": 30,
+      "active": true,
+      "tags": ["developer", "rust"]
+    },
+    "padding": vec![padding_entry; entries.max(1)]
+  });
+
+  let config = parse_config(json!({
+    "format": "json",
+    "extractors": [
+      {
+        "id": "userName",
+        "description": "User name",
+        "selector": ["user", "name"],
+        "type": "string",
+        "predicates": [
+          { "type": "length", "comparison": "greaterThan", "value": 3 }
+        ]
+      },
+      {
+        "id": "userAge",
+        "description": "User age",
+        "selector": ["user", "age"],
+        "type": "number",
+        "predicates": [
+          { "type": "value", "comparison": "greaterThanOrEqual", "value": 18 }
+        ]
+      },
+      {
+        "id": "userTags",
+        "description": "User tags",
+        "selector": ["user", "tags"],
+        "type": "array"
+      }
+    ]
+  }));
+
+  (serde_json::to_vec(&body).unwrap(), config)
+}
+
+/// Builds an HTML body of roughly `target_bytes` by repeating feature cards
+/// under a shared selector chain, mirroring the manifests our fleet runs
+fn synth_html(target_bytes: usize) -> (Vec<u8>, ExtractorConfig) {
+  let card = concat!(
+    "<article class=\"feature-card\">",
+    "<h3 class=\"feature-title\">Lightning Fast</h3>",
+    "<p class=\"feature-description\">Our platform responds in milliseconds, ",
+    "keeping your users engaged and your bounce rates low.</p>",
+    "<div class=\"feature-meta\"><span class=\"feature-rating\" ",
+    "data-rating=\"4.8\">4.8 stars</span></div>",
+    "</article>"
+  );
+  let cards = (target_bytes / card.len()).max(1);
+
+  let mut html = String::with_capacity(target_bytes + 512);
+  html.push_str("<!DOCTYPE html><html><head><title>Benchmark Page</title></head><body>");
+  html.push_str("<main><section class=\"features-section\"><div class=\"features-grid\">");
+  for _ in 0..cards {
+    html.push_str(card);
+  }
+  html.push_str("</div></section></main></body></html>");
+
+  let config = parse_config(json!({
+    "format": "html",
+    "extractors": [
+      {
+        "id": "pageTitle",
+        "description": "Page title",
+        "selector": ["title"],
+        "type": "string"
+      },
+      {
+        "id": "featureTitles",
+        "description": "Feature titles",
+        "selector": [
+          "main", "section.features-section", "div.features-grid",
+          "article.feature-card", "h3.feature-title"
+        ],
+        "type": "array"
+      },
+      {
+        "id": "featureRatings",
+        "description": "Feature ratings",
+        "selector": [
+          "main", "section.features-section", "div.features-grid",
+          "article.feature-card", "span.feature-rating"
+        ],
+        "type": "array",
+        "attribute": "data-rating"
+      }
+    ]
+  }));
+
+  (html.into_bytes(), config)
+}
+
+fn bench_extract_and_validate_json(c: &mut Criterion) {
+  let mut group = c.benchmark_group("extract_and_validate/json");
+  for (label, size) in BODY_SIZES {
+    let (body, config) = synth_json(*size);
+    group.throughput(Throughput::Bytes(body.len() as u64));
+    group.bench_with_input(BenchmarkId::from_parameter(label), &body, |b, body| {
+      b.iter(|| config.extract_and_validate(black_box(body)).unwrap())
+    });
+  }
+  group.finish();
+}
+
+fn bench_extract_and_validate_html(c: &mut Criterion) {
+  let mut group = c.benchmark_group("extract_and_validate/html");
+  for (label, size) in BODY_SIZES {
+    let (body, config) = synth_html(*size);
+    group.throughput(Throughput::Bytes(body.len() as u64));
+    group.bench_with_input(BenchmarkId::from_parameter(label), &body, |b, body| {
+      b.iter(|| config.extract_and_validate(black_box(body)).unwrap())
+    });
+  }
+  group.finish();
+}
+
+fn bench_extract_and_validate_fixtures(c: &mut Criterion) {
+  let fixtures: &[(&str, &[u8], &str)] = &[
+    ("coinbase.json", include_bytes!("../fixtures/coinbase.json"), "json"),
+    ("website.html", include_bytes!("../fixtures/website.html"), "html"),
+    ("claude_shannon.html", include_bytes!("../fixtures/claude_shannon.html"), "html"),
+  ];
+
+  let mut group = c.benchmark_group("extract_and_validate/fixtures");
+  for (label, body, format) in fixtures {
+    // A lenient optional extractor, so the benchmark measures parse plus
+    // traversal on real-world documents regardless of their exact shape
+    let selector = if *format == "json" { json!(["data"]) } else { json!(["title"]) };
+    let config = parse_config(json!({
+      "format": format,
+      "extractors": [{
+        "id": "probe",
+        "description": "Fixture probe",
+        "selector": selector,
+        "type": "string",
+        "required": false
+      }]
+    }));
+    group.throughput(Throughput::Bytes(body.len() as u64));
+    group.bench_with_input(BenchmarkId::from_parameter(label), body, |b, body| {
+      b.iter(|| config.extract_and_validate(black_box(body)).unwrap())
+    });
+  }
+  group.finish();
+}
+
+fn bench_validate_predicate(c: &mut Criterion) {
+  let cases: Vec<(&str, Value, Predicate)> = vec![
+    (
+      "value_gte",
+      json!(42),
+      serde_json::from_value(json!({
+        "type": "value", "comparison": "greaterThanOrEqual", "value": 18
+      }))
+      .unwrap(),
+    ),
+    (
+      "length_gt",
+      json!("a reasonably long extracted string"),
+      serde_json::from_value(json!({
+        "type": "length", "comparison": "greaterThan", "value": 10
+      }))
+      .unwrap(),
+    ),
+    (
+      "regex_match",
+      json!("user-12345@example.com"),
+      serde_json::from_value(json!({
+        "type": "regex", "comparison": "equal",
+        "value": "^[a-z0-9-]+@[a-z]+\\.[a-z]+$", "flags": "i"
+      }))
+      .unwrap(),
+    ),
+    (
+      "string_starts_with",
+      json!("prefix-payload"),
+      serde_json::from_value(json!({
+        "type": "string", "comparison": "startsWith", "value": "prefix"
+      }))
+      .unwrap(),
+    ),
+    (
+      "array_includes",
+      json!(["developer", "rust", "web"]),
+      serde_json::from_value(json!({
+        "type": "array", "comparison": "includes", "value": "rust"
+      }))
+      .unwrap(),
+    ),
+  ];
+
+  let mut group = c.benchmark_group("validate_predicate");
+  for (label, value, predicate) in &cases {
+    group.bench_with_input(BenchmarkId::from_parameter(*label), &(), |b, _| {
+      b.iter(|| validate_predicate(black_box(value), black_box(predicate)).unwrap())
+    });
+  }
+  group.finish();
+}
+
+fn bench_manifest_digest(c: &mut Criterion) {
+  let manifest: Manifest = serde_json::from_str(TEST_MANIFEST).unwrap();
+  c.bench_function("manifest/to_keccak_digest", |b| {
+    b.iter(|| black_box(&manifest).to_keccak_digest().unwrap())
+  });
+}
+
+fn bench_match_and_extract(c: &mut Criterion) {
+  let manifest: Manifest = serde_json::from_str(TEST_MANIFEST).unwrap();
+  let body = serde_json::to_vec(&json!({ "hello": "world" })).unwrap();
+  let notary_response = NotaryResponse {
+    response:             manifest.response.clone(),
+    notary_response_body: web_prover_core::http::NotaryResponseBody { body: Some(body) },
+  };
+
+  c.bench_function("notary_response/match_and_extract", |b| {
+    b.iter(|| notary_response.match_and_extract(black_box(&manifest.response)).unwrap())
+  });
+}
+
+criterion_group!(
+  benches,
+  bench_extract_and_validate_json,
+  bench_extract_and_validate_html,
+  bench_extract_and_validate_fixtures,
+  bench_validate_predicate,
+  bench_manifest_digest,
+  bench_match_and_extract
+);
+criterion_main!(benches);
@@ -28,6 +28,10 @@ pub enum WebProverCoreError {
   /// Indicates that extraction failed
   #[error("Extraction failed: {0}")]
   ExtractionFailed(String),
+
+  /// Compact proof encoding or decoding failed
+  #[error("Proof encoding error: {0}")]
+  ProofEncoding(String),
 }
 
 #[derive(Debug, Error)]
@@ -9,3 +9,74 @@ pub fn keccak_digest(bytes: &[u8]) -> [u8; 32] {
 
   output
 }
+
+/// Streaming Keccak-256 hasher.
+///
+/// Wraps the sponge state behind an update/finalize API so multi-part digests
+/// fold into one state without concatenating the parts into an intermediate
+/// buffer first. Feeding the same bytes in any chunking produces the same
+/// digest as a single [`keccak_digest`] call.
+///
+/// Also implements [`std::io::Write`], so serializers can stream straight
+/// into the hash state (e.g. `serde_json::to_writer`).
+pub struct IncrementalKeccak {
+  state: Keccak,
+}
+
+impl IncrementalKeccak {
+  pub fn new() -> Self { Self { state: Keccak::v256() } }
+
+  /// Absorbs `bytes` into the hash state.
+  pub fn update(&mut self, bytes: &[u8]) { self.state.update(bytes); }
+
+  /// Consumes the hasher and returns the 32-byte digest.
+  pub fn finalize(self) -> [u8; 32] {
+    let mut output = [0u8; 32];
+    self.state.finalize(&mut output);
+    output
+  }
+}
+
+impl Default for IncrementalKeccak {
+  fn default() -> Self { Self::new() }
+}
+
+impl std::io::Write for IncrementalKeccak {
+  fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+    self.update(buf);
+    Ok(buf.len())
+  }
+
+  fn flush(&mut self) -> std::io::Result<()> { Ok(()) }
+}
+
+#[cfg(test)]
+mod tests {
+  use std::io::Write;
+
+  use super::*;
+
+  #[test]
+  fn test_incremental_matches_one_shot() {
+    let data = b"the quick brown fox jumps over the lazy dog";
+    let one_shot = keccak_digest(data);
+
+    for split in [0, 1, data.len() / 2, data.len()] {
+      let mut hasher = IncrementalKeccak::new();
+      hasher.update(&data[..split]);
+      hasher.update(&data[split..]);
+      assert_eq!(hasher.finalize(), one_shot);
+    }
+  }
+
+  #[test]
+  fn test_write_adapter_matches_one_shot() {
+    let value = serde_json::json!({"key": [1, 2, 3], "nested": {"ok": true}});
+    let one_shot = keccak_digest(&serde_json::to_vec(&value).unwrap());
+
+    let mut hasher = IncrementalKeccak::new();
+    serde_json::to_writer(&mut hasher, &value).unwrap();
+    hasher.flush().unwrap();
+    assert_eq!(hasher.finalize(), one_shot);
+  }
+}
@@ -23,7 +23,7 @@ use crate::{
   manifest::ManifestValidationResult,
   parser::{DataFormat, ExtractorConfig},
   template,
-  template::TemplateVar,
+  template::{TemplateVar, TokenField, TokenIndex},
 };
 
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
@@ -40,6 +40,29 @@ pub const MAX_HTTP_HEADERS: usize = 25;
 /// HTTP/1.1
 pub const HTTP_1_1: &str = "HTTP/1.1";
 
+/// Looks up a header by ASCII-case-insensitive name without allocating.
+///
+/// The exact spelling is tried first so the common case stays a single hash
+/// lookup; only on a miss do we fall back to a linear scan that folds case on
+/// the fly. Header maps are bounded by [`MAX_HTTP_HEADERS`], so the scan stays
+/// cheap.
+fn get_header_ci<'a>(headers: &'a HashMap<String, String>, name: &str) -> Option<&'a String> {
+  headers
+    .get(name)
+    .or_else(|| headers.iter().find(|(key, _)| key.eq_ignore_ascii_case(name)).map(|(_, v)| v))
+}
+
+/// Checks that `value` is `media_type`, optionally followed by parameters
+/// (e.g. `; charset=utf-8`), comparing ASCII-case-insensitively without
+/// allocating.
+fn matches_media_type(value: &str, media_type: &str) -> bool {
+  match value.as_bytes().get(media_type.len()) {
+    None => value.eq_ignore_ascii_case(media_type),
+    Some(b';') => value[..media_type.len()].eq_ignore_ascii_case(media_type),
+    Some(_) => false,
+  }
+}
+
 /// A type of response body used to describe conditions in the client `Manifest`.
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq, Default)]
 pub struct ManifestResponseBody(pub ExtractorConfig);
@@ -199,13 +222,8 @@ impl NotaryResponse {
     }
 
     for (key, other_value) in &other.headers {
-      match self
-        .response
-        .headers
-        .get(key)
-        .or_else(|| self.response.headers.get(&key.to_lowercase()))
-      {
-        Some(actual_value) if actual_value.to_lowercase() == other_value.to_lowercase() => continue,
+      match get_header_ci(&self.response.headers, key) {
+        Some(actual_value) if actual_value.eq_ignore_ascii_case(other_value) => continue,
         Some(actual_value) => {
           result.report_error(
             ManifestHttpError::HeaderMismatch {
@@ -229,7 +247,7 @@ impl NotaryResponse {
 
     // Check body
     let body_result = self.body_matches(other)?;
-    result.merge(&body_result);
+    result.merge(body_result);
 
     // Return combined result
     Ok(result)
@@ -245,7 +263,6 @@ impl NotaryResponse {
     match &self.notary_response_body.body {
       Some(body) => {
         let extraction_result = other.body.0.extract_and_validate(body)?;
-        result.merge_extraction_result(&extraction_result);
 
         if !extraction_result.is_success() {
           result.report_error(WebProverCoreError::ExtractionFailed(
@@ -259,6 +276,8 @@ impl NotaryResponse {
           ));
         }
 
+        result.merge_extraction_result(extraction_result);
+
         debug!("Client response matches");
         Ok(result)
       },
@@ -342,18 +361,15 @@ impl ManifestResponse {
       ));
     }
 
-    let content_type =
-      self.headers.get("Content-Type").or_else(|| self.headers.get("content-type"));
+    let content_type = get_header_ci(&self.headers, "Content-Type");
     if content_type.is_none() {
       return Err(WebProverCoreError::InvalidManifest("Missing 'Content-Type' header".to_string()));
     }
     let content_type = content_type.unwrap();
 
     const VALID_CONTENT_TYPES: [&str; 3] = ["application/json", "text/plain", "text/html"];
-    let is_valid_content_type = VALID_CONTENT_TYPES.iter().any(|&legal_type| {
-      let content_type = content_type.to_lowercase();
-      content_type == legal_type || content_type.starts_with(&format!("{};", legal_type))
-    });
+    let is_valid_content_type =
+      VALID_CONTENT_TYPES.iter().any(|&legal_type| matches_media_type(content_type, legal_type));
     if !is_valid_content_type {
       return Err(WebProverCoreError::InvalidManifest(
         "Invalid Content-Type header: ".to_string() + content_type,
@@ -361,7 +377,7 @@ impl ManifestResponse {
     }
 
     // When Content-Type is application/json, we expect at least one JSON item
-    if content_type == "application/json" {
+    if content_type.eq_ignore_ascii_case("application/json") {
       if self.body.0.format != DataFormat::Json {
         return Err(WebProverCoreError::InvalidManifest("Expected JSON format".to_string()));
       }
@@ -461,8 +477,28 @@ impl ManifestRequest {
     all_tokens
   }
 
-  fn validate_tokens(&self, tokens: &[String]) -> Result<(), WebProverCoreError> {
-    for token in tokens {
+  /// Builds the index of template tokens in this request's body and headers.
+  /// The result only depends on the manifest, so compiled manifests build it
+  /// once and reuse it for every notarization.
+  pub fn token_index(&self) -> TokenIndex {
+    let mut index = TokenIndex::default();
+    if let Some(body) = self.body.as_ref() {
+      index.index_value("", body);
+    }
+    for (name, value) in &self.headers {
+      index.index_string(&TokenField::Header(name.clone()), value);
+    }
+    index
+  }
+
+  pub fn validate_vars(&self) -> Result<(), WebProverCoreError> {
+    self.validate_vars_with(&self.token_index())
+  }
+
+  /// Validates declared vars against a prebuilt token index, skipping the
+  /// document scan
+  pub fn validate_vars_with(&self, tokens: &TokenIndex) -> Result<(), WebProverCoreError> {
+    for token in tokens.tokens() {
       if !self.vars.contains_key(token) {
         return Err(WebProverCoreError::InvalidManifest(format!(
           "Token `<% {} %>` not declared in `vars`",
@@ -470,16 +506,9 @@ impl ManifestRequest {
         )));
       }
     }
-    Ok(())
-  }
-
-  pub fn validate_vars(&self) -> Result<(), WebProverCoreError> {
-    let all_tokens = self.collect_tokens();
-    self.validate_tokens(&all_tokens)?;
 
     for (key, variable) in &self.vars {
-      let is_used = all_tokens.contains(key);
-      variable.validate(key, is_used)?;
+      variable.validate(key, tokens.contains(key))?;
     }
 
     Ok(())
@@ -561,8 +590,7 @@ impl ManifestRequest {
 
     // Check if all headers in `self` exist in `other` with the same value
     for (key, value) in &self.headers {
-      let expected_header =
-        other.headers.get(key).or_else(|| other.headers.get(&key.to_lowercase()));
+      let expected_header = get_header_ci(&other.headers, key);
       if expected_header != Some(value) {
         result.report_error(
           ManifestHttpError::HeaderMismatch {
@@ -619,6 +647,124 @@ impl ManifestRequest {
 
     Ok(result)
   }
+
+  /// Precomputes this request's matching state for repeated
+  /// [`is_subset_of`](Self::is_subset_of)-style checks; compiled manifests
+  /// build it once and reuse it for every notarization.
+  pub fn compile_matcher(&self) -> Result<CompiledRequestMatcher, WebProverCoreError> {
+    let parsed_url = url::Url::parse(&self.url)
+      .map_err(|_| WebProverCoreError::InvalidManifest("Invalid URL: ".to_string() + &self.url))?;
+    let mut headers: Vec<(String, String)> =
+      self.headers.iter().map(|(name, value)| (name.to_ascii_lowercase(), value.clone())).collect();
+    headers.sort_by(|a, b| a.0.cmp(&b.0));
+    Ok(CompiledRequestMatcher {
+      method: self.method.clone(),
+      url: self.url.clone(),
+      parsed_url,
+      version: self.version.clone(),
+      headers,
+      vars: self.vars.clone(),
+    })
+  }
+}
+
+/// Request-matching state precomputed from a manifest's [`ManifestRequest`].
+///
+/// [`ManifestRequest::is_subset_of`] runs on every notarization and pays a
+/// case-folding header probe per locked header. The compiled matcher folds
+/// and sorts the manifest's header names once, so the per-request check is a
+/// single linear merge against the incoming headers, and it keeps the
+/// manifest URL pre-parsed so callers never re-parse it.
+#[derive(Debug, Clone)]
+pub struct CompiledRequestMatcher {
+  method:     String,
+  url:        String,
+  parsed_url: url::Url,
+  version:    String,
+  /// Locked headers with names folded to lowercase, sorted by name for
+  /// merge-join comparison
+  headers:    Vec<(String, String)>,
+  vars:       HashMap<String, TemplateVar>,
+}
+
+impl CompiledRequestMatcher {
+  /// Returns the manifest URL parsed once at compile time.
+  pub fn parsed_url(&self) -> &url::Url { &self.parsed_url }
+
+  /// Equivalent of [`ManifestRequest::is_subset_of`] with the manifest as
+  /// `self`: checks that every locked header, var, and start-line field of
+  /// the manifest is satisfied by `other`, reporting the same errors.
+  pub fn matches(&self, other: &ManifestRequest) -> ManifestValidationResult {
+    let mut result = ManifestValidationResult::default();
+
+    // Fold and sort the incoming header names once, then merge-join against
+    // the pre-sorted manifest headers instead of probing per header
+    let mut incoming: Vec<(String, &String)> =
+      other.headers.iter().map(|(name, value)| (name.to_ascii_lowercase(), value)).collect();
+    incoming.sort_by(|a, b| a.0.cmp(&b.0));
+
+    let mut cursor = 0;
+    for (name, expected) in &self.headers {
+      while cursor < incoming.len() && incoming[cursor].0.as_str() < name.as_str() {
+        cursor += 1;
+      }
+      let actual = incoming
+        .get(cursor)
+        .and_then(|(incoming_name, value)| (incoming_name == name).then_some(*value));
+      if actual != Some(expected) {
+        result.report_error(
+          ManifestHttpError::HeaderMismatch {
+            expected: expected.clone(),
+            actual:   actual.cloned().unwrap_or_else(|| "missing".to_string()),
+          }
+          .into(),
+        );
+      }
+    }
+
+    for (key, var) in &self.vars {
+      match other.vars.get(key) {
+        Some(other_var) =>
+          if var != other_var {
+            result.report_error(WebProverCoreError::Template(TemplateError::VariableMismatch {
+              key: key.clone(),
+            }))
+          },
+        None => result.report_error(WebProverCoreError::Template(TemplateError::VariableMissing {
+          key: key.clone(),
+        })),
+      }
+    }
+
+    if self.method != other.method {
+      result.report_error(
+        ManifestHttpError::MethodMismatch {
+          expected: other.method.clone(),
+          actual:   self.method.clone(),
+        }
+        .into(),
+      );
+    }
+
+    if self.url != other.url {
+      result.report_error(
+        ManifestHttpError::UrlMismatch { expected: other.url.clone(), actual: self.url.clone() }
+          .into(),
+      );
+    }
+
+    if self.version != other.version {
+      result.report_error(
+        ManifestHttpError::VersionMismatch {
+          expected: other.version.clone(),
+          actual:   self.version.clone(),
+        }
+        .into(),
+      );
+    }
+
+    result
+  }
 }
 
 #[cfg(test)]
@@ -689,7 +835,9 @@ pub mod tests {
                       required: true,
                       predicates: vec![],
                       attribute: None,
+                      compiled_predicates: Default::default(),
                     }],
+                  early_exit: false,
                 },
             },
         };
@@ -754,6 +902,7 @@ pub mod tests {
                 selector: vec!["key1".to_string(), "key2".to_string()],
                 extractor_type: ExtractorType::Number,
             )],
+          early_exit: false,
         })
     );
     let notary_response = notary_response!(
@@ -787,6 +936,30 @@ pub mod tests {
     assert!(response_superset.match_and_extract(&response).unwrap().is_success());
   }
 
+  #[test]
+  fn test_headers_match_case_insensitively() {
+    let response = response!(body: ManifestResponseBody::default());
+    let notary_response = notary_response!(
+      response!(
+        headers: HashMap::from([("content-type".to_string(), "APPLICATION/JSON".to_string())]),
+        body: ManifestResponseBody::default(),
+      ),
+      body: Some(json!({"key1": "value1"}).to_string().into_bytes().to_vec()),
+    );
+
+    // Header name and value spelling differ only by ASCII case
+    assert!(notary_response.match_and_extract(&response).unwrap().is_success());
+  }
+
+  #[test]
+  fn test_matches_media_type() {
+    assert!(matches_media_type("application/json", "application/json"));
+    assert!(matches_media_type("Application/JSON", "application/json"));
+    assert!(matches_media_type("text/html; charset=utf-8", "text/html"));
+    assert!(!matches_media_type("text/htmlx", "text/html"));
+    assert!(!matches_media_type("text/htm", "text/html"));
+  }
+
   #[test]
   fn test_response_with_missing_body() {
     let header_bytes: &[u8] = b"HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n\r\n";
@@ -885,6 +1058,7 @@ pub mod tests {
                 selector: vec!["missingKey".to_string()],
                 extractor_type: ExtractorType::String,
             )],
+          early_exit: false,
         })
     );
     assert!(!base_response.match_and_extract(&other_response).unwrap().is_success());
@@ -1007,4 +1181,38 @@ pub mod tests {
 
     assert!(request.validate_vars().is_ok());
   }
+
+  #[test]
+  fn test_compiled_matcher_agrees_with_is_subset_of() {
+    let manifest_request = request!();
+    let matcher = manifest_request.compile_matcher().unwrap();
+
+    let matching = request!();
+    let mismatching = request!(
+      method: "POST".to_string(),
+      url: "https://other.example".to_string(),
+      headers: std::collections::HashMap::from([
+        ("User-Agent".to_string(), "other-agent".to_string()),
+      ])
+    );
+
+    for other in [&matching, &mismatching] {
+      let interpreted = manifest_request.is_subset_of(other).unwrap();
+      let compiled = matcher.matches(other);
+      assert_eq!(compiled.is_success(), interpreted.is_success());
+      // Header iteration order differs between the paths; the error sets must
+      // still be identical
+      let mut interpreted_errors = interpreted.errors();
+      interpreted_errors.sort_unstable();
+      let mut compiled_errors = compiled.errors();
+      compiled_errors.sort_unstable();
+      assert_eq!(compiled_errors, interpreted_errors);
+    }
+
+    // Case-folded header names still match after compilation
+    let mut cased = request!();
+    let value = cased.headers.remove("User-Agent").unwrap();
+    cased.headers.insert("USER-AGENT".to_string(), value);
+    assert!(matcher.matches(&cased).is_success());
+  }
 }
@@ -7,8 +7,9 @@ use tracing::debug;
 use crate::{
   error::WebProverCoreError,
   hash::keccak_digest,
-  http::{ManifestRequest, ManifestResponse, NotaryResponse},
+  http::{CompiledRequestMatcher, ManifestRequest, ManifestResponse, NotaryResponse},
   parser::{ExtractionResult, ExtractionValues},
+  template::TokenIndex,
 };
 
 /// Manifest validation summary
@@ -88,7 +89,7 @@ impl fmt::Display for ManifestValidationResult {
     let values = self.values();
     if !values.is_empty() {
       writeln!(f, "Successfully extracted {} values:", values.len())?;
-      for (key, value) in &values {
+      for (key, value) in values {
         let value_str = if value.to_string().len() > 50 {
           format!("{}... (truncated)", &value.to_string()[..47])
         } else {
@@ -111,6 +112,7 @@ fn get_error_category(error: &WebProverCoreError) -> &'static str {
     WebProverCoreError::Template(_) => "template_validation",
     WebProverCoreError::ExtractionFailed(_) => "extraction",
     WebProverCoreError::ExtractorError(_) => "extraction",
+    WebProverCoreError::ProofEncoding(_) => "serialization",
   }
 }
 
@@ -119,27 +121,32 @@ impl ManifestValidationResult {
   pub fn is_success(&self) -> bool { self.errors.is_empty() && self.extraction_result.is_success() }
 
   /// Returns the extracted values
-  pub fn values(&self) -> ExtractionValues { self.extraction_result.values.clone() }
+  pub fn values(&self) -> &ExtractionValues { &self.extraction_result.values }
 
   /// Adds an error to the summary
   pub fn add_error(&mut self, error: &str) { self.errors.push(error.to_string()); }
 
-  /// Appends an extraction result to the summary
-  pub fn merge_extraction_result(&mut self, other: &ExtractionResult) {
+  /// Appends an extraction result to the summary, taking ownership of its
+  /// values and errors
+  pub fn merge_extraction_result(&mut self, other: ExtractionResult) {
     self.extraction_result.merge(other);
   }
 
-  /// Merges another validation result into this one
-  pub fn merge(&mut self, other: &ManifestValidationResult) {
-    self.errors.extend(other.clone().errors);
-    self.extraction_result.merge(&other.extraction_result);
+  /// Merges another validation result into this one, taking ownership so
+  /// values and error strings move instead of being deep-copied
+  pub fn merge(&mut self, other: ManifestValidationResult) {
+    self.errors.extend(other.errors);
+    self.extraction_result.merge(other.extraction_result);
   }
 
   /// Returns validation and extraction errors
-  pub fn errors(&self) -> Vec<String> {
-    let mut errors = self.errors.clone();
-    errors.extend(self.extraction_result.errors.clone());
-    errors
+  pub fn errors(&self) -> Vec<&str> {
+    self
+      .errors
+      .iter()
+      .map(String::as_str)
+      .chain(self.extraction_result.errors.iter().map(String::as_str))
+      .collect()
   }
 
   /// Adds an error to the summary and logs it with structured context
@@ -163,17 +170,24 @@ impl ManifestValidationResult {
 #[serde(rename_all = "camelCase")]
 pub struct Manifest {
   /// Manifest version
-  pub manifest_version: String,
+  pub manifest_version:  String,
   /// ID of the manifest
-  pub id:               Option<String>,
+  pub id:                Option<String>,
   /// Title of the manifest
-  pub title:            Option<String>,
+  pub title:             Option<String>,
   /// Description of the manifest
-  pub description:      Option<String>,
+  pub description:       Option<String>,
   /// HTTP request lock items
-  pub request:          ManifestRequest,
+  pub request:           ManifestRequest,
   /// HTTP response lock items
-  pub response:         ManifestResponse,
+  pub response:          ManifestResponse,
+  /// Optional freshness window, in seconds, during which a notary may serve a
+  /// cached proof for an identical (manifest, request) pair instead of
+  /// re-fetching the target. Absent means proofs are never served from cache.
+  /// Skipped during serialization when absent so existing manifests keep
+  /// their digest.
+  #[serde(default, skip_serializing_if = "Option::is_none")]
+  pub cache_ttl_seconds: Option<u64>,
 }
 
 impl Manifest {
@@ -215,13 +229,13 @@ impl Manifest {
     let mut result = ManifestValidationResult::default();
 
     // Validate manifest fields
-    result.merge(&self.validate_manifest()?);
+    result.merge(self.validate_manifest()?);
 
     // Check if request matches manifest requirements
-    result.merge(&self.request.is_subset_of(request)?);
+    result.merge(self.request.is_subset_of(request)?);
 
     // Check if response matches manifest and extract values
-    result.merge(&response.match_and_extract(&self.response)?);
+    result.merge(response.match_and_extract(&self.response)?);
 
     Ok(result)
   }
@@ -231,6 +245,75 @@ impl Manifest {
     let as_bytes: Vec<u8> = self.try_into()?;
     Ok(keccak_digest(&as_bytes))
   }
+
+  /// Compiles the manifest for repeated evaluation.
+  ///
+  /// Compilation performs the work that depends only on the manifest itself —
+  /// serialization into its keccak digest and static validation of the request,
+  /// response, and template variables — exactly once, so callers serving the
+  /// same manifest over and over can skip it on every subsequent request.
+  pub fn compile(self) -> Result<CompiledManifest, WebProverCoreError> {
+    let digest = self.to_keccak_digest()?;
+    let static_validation = self.validate_manifest()?;
+    let token_index = self.request.token_index();
+    let request_matcher = self.request.compile_matcher()?;
+    // Warm each extractor's predicate plans so the first notarization against
+    // this manifest pays no predicate compilation cost either
+    for extractor in &self.response.body.0.extractors {
+      extractor.compiled_predicates.get_or_compile(&extractor.predicates);
+    }
+    Ok(CompiledManifest { manifest: self, digest, static_validation, token_index, request_matcher })
+  }
+}
+
+/// A [`Manifest`] compiled once for repeated evaluation.
+///
+/// Produced by [`Manifest::compile`]. Holds the manifest's keccak digest and
+/// the result of its static validation so that per-request validation via
+/// [`CompiledManifest::validate_with`] only performs the request- and
+/// response-dependent checks.
+#[derive(Debug, Clone)]
+pub struct CompiledManifest {
+  manifest:          Manifest,
+  digest:            [u8; 32],
+  static_validation: ManifestValidationResult,
+  token_index:       TokenIndex,
+  /// Request matcher with pre-folded, sorted headers and a pre-parsed URL,
+  /// built once so per-request subset checks do no parsing or case folding
+  /// of the manifest side.
+  request_matcher:   CompiledRequestMatcher,
+}
+
+impl CompiledManifest {
+  /// Returns the underlying manifest
+  pub fn manifest(&self) -> &Manifest { &self.manifest }
+
+  /// Returns the precomputed keccak digest of the serialized manifest
+  pub fn digest(&self) -> [u8; 32] { self.digest }
+
+  /// Returns the template-token index built from the request at compile time,
+  /// so variable validation and substitution are indexed lookups instead of a
+  /// document scan
+  pub fn token_index(&self) -> &TokenIndex { &self.token_index }
+
+  /// Equivalent to [`Manifest::validate_with`], but reuses the static
+  /// validation result computed at compile time instead of re-validating the
+  /// manifest on every request.
+  pub fn validate_with(
+    &self,
+    request: &ManifestRequest,
+    response: &NotaryResponse,
+  ) -> Result<ManifestValidationResult, WebProverCoreError> {
+    let mut result = self.static_validation.clone();
+
+    // Check if request matches manifest requirements
+    result.merge(self.request_matcher.matches(request));
+
+    // Check if response matches manifest and extract values
+    result.merge(response.match_and_extract(&self.manifest.response)?);
+
+    Ok(result)
+  }
 }
 
 impl TryFrom<&[u8]> for Manifest {
@@ -280,6 +363,7 @@ mod tests {
             description: Some("Default description.".to_string()),
             request: $request,
             response: $response,
+            cache_ttl_seconds: None,
             $(
                 $field: $value,
             )*
@@ -310,6 +394,7 @@ mod tests {
         selector:       vec!["hello".to_string()],
         extractor_type: ExtractorType::String,
       }],
+      early_exit: false,
     });
     assert_eq!(manifest.response.body, expected_body);
   }
@@ -463,14 +548,14 @@ mod tests {
 
     let extraction = ExtractionResult { values, errors: vec!["extraction error".to_string()] };
 
-    result.merge_extraction_result(&extraction);
+    result.merge_extraction_result(extraction);
 
     // Test that both validation and extraction errors are returned
     result.add_error("validation error");
     let all_errors = result.errors();
     assert_eq!(all_errors.len(), 2);
-    assert!(all_errors.contains(&"validation error".to_string()));
-    assert!(all_errors.contains(&"extraction error".to_string()));
+    assert!(all_errors.contains(&"validation error"));
+    assert!(all_errors.contains(&"extraction error"));
 
     // Test values are accessible
     let values = result.values();
@@ -491,7 +576,7 @@ mod tests {
     result1.add_error("error1");
     let mut values1 = ExtractionValues::new();
     values1.insert("key1".to_string(), json!("value1"));
-    result1.merge_extraction_result(&ExtractionResult {
+    result1.merge_extraction_result(ExtractionResult {
       values: values1,
       errors: vec!["extraction1".to_string()],
     });
@@ -500,21 +585,21 @@ mod tests {
     result2.add_error("error2");
     let mut values2 = ExtractionValues::new();
     values2.insert("key2".to_string(), json!("value2"));
-    result2.merge_extraction_result(&ExtractionResult {
+    result2.merge_extraction_result(ExtractionResult {
       values: values2,
       errors: vec!["extraction2".to_string()],
     });
 
     // Merge results
-    result1.merge(&result2);
+    result1.merge(result2);
 
     // Verify merged state
     let all_errors = result1.errors();
     assert_eq!(all_errors.len(), 4);
-    assert!(all_errors.contains(&"error1".to_string()));
-    assert!(all_errors.contains(&"error2".to_string()));
-    assert!(all_errors.contains(&"extraction1".to_string()));
-    assert!(all_errors.contains(&"extraction2".to_string()));
+    assert!(all_errors.contains(&"error1"));
+    assert!(all_errors.contains(&"error2"));
+    assert!(all_errors.contains(&"extraction1"));
+    assert!(all_errors.contains(&"extraction2"));
 
     let values = result1.values();
     assert_eq!(values.get("key1"), Some(&json!("value1")));
@@ -532,7 +617,7 @@ mod tests {
     // Test with successful extraction only
     let mut values = ExtractionValues::new();
     values.insert("key".to_string(), json!("value"));
-    result.merge_extraction_result(&ExtractionResult { values, errors: vec![] });
+    result.merge_extraction_result(ExtractionResult { values, errors: vec![] });
 
     assert!(result.is_success());
     assert!(result.is_success());
@@ -555,7 +640,7 @@ mod tests {
     let mut values = ExtractionValues::new();
     values.insert("key1".to_string(), json!("value1"));
     values.insert("key2".to_string(), json!(42));
-    result.merge_extraction_result(&ExtractionResult { values, errors: vec![] });
+    result.merge_extraction_result(ExtractionResult { values, errors: vec![] });
 
     // Convert to string representation
     let display_output = result.to_string();
@@ -627,6 +712,7 @@ mod tests {
                       extractor_type: ExtractorType::Number,
                   }
               ],
+            early_exit: false,
           })
       ),
     );
@@ -669,6 +755,26 @@ mod tests {
     assert!(result.values().is_empty());
   }
 
+  #[test]
+  fn test_compiled_manifest_matches_uncompiled_validation() {
+    let manifest: Manifest = serde_json::from_str(TEST_MANIFEST).unwrap();
+    let request = manifest.request.clone();
+    let response = NotaryResponse {
+      response:             manifest.response.clone(),
+      notary_response_body: NotaryResponseBody {
+        body: Some(serde_json::json!({"hello": "world"}).to_string().into_bytes()),
+      },
+    };
+
+    let compiled = manifest.clone().compile().unwrap();
+    assert_eq!(compiled.digest(), manifest.to_keccak_digest().unwrap());
+    assert_eq!(compiled.manifest(), &manifest);
+
+    let compiled_result = compiled.validate_with(&request, &response).unwrap();
+    let uncompiled_result = manifest.validate_with(&request, &response).unwrap();
+    assert_eq!(compiled_result, uncompiled_result);
+  }
+
   #[test]
   fn test_manifest_with_a_wrong_version() {
     let mut manifest = create_manifest!(request!(), response!(),);
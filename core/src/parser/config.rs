@@ -35,19 +35,42 @@ pub struct ExtractorConfig {
   pub format:     DataFormat,
   /// The list of extractors
   pub extractors: Vec<Extractor>,
+  /// Opt-in: the notary may stop reading the upstream body as soon as every
+  /// extractor is satisfied by the prefix received so far. This changes what
+  /// is attested — the proof covers only the consumed prefix, and optional
+  /// extractors whose data arrives later are dropped — so it defaults to off.
+  /// Skipped during serialization when false so existing manifests keep their
+  /// digest.
+  #[serde(default, skip_serializing_if = "std::ops::Not::not")]
+  pub early_exit: bool,
 }
 
 impl ExtractorConfig {
   /// Use document-specific extractors to extract and validate data
+  ///
+  /// Input validation happens inside `extract` so the document is parsed
+  /// exactly once per call.
   pub fn extract_and_validate(&self, data: &[u8]) -> Result<ExtractionResult, ExtractorError> {
     let extractor: Box<dyn DocumentExtractor> = match self.format {
       DataFormat::Json => Box::new(JsonDocumentExtractor),
       DataFormat::Html => Box::new(HtmlDocumentExtractor),
     };
 
-    extractor.validate_input(data)?;
     extractor.extract(data, self)
   }
+
+  /// Returns `true` if `result` resolves every required extractor with no
+  /// errors, i.e. a body prefix that produced it contains everything this
+  /// config asks for and reading further cannot improve the outcome for
+  /// required extractors.
+  pub fn is_satisfied_by(&self, result: &ExtractionResult) -> bool {
+    result.is_success()
+      && self
+        .extractors
+        .iter()
+        .filter(|extractor| extractor.required)
+        .all(|extractor| result.values.contains_key(&extractor.id))
+  }
 }
 
 #[cfg(test)]
@@ -79,6 +102,7 @@ mod tests {
     let config = ExtractorConfig {
       format:     DataFormat::Json,
       extractors: vec![name_extractor(), age_extractor(), active_extractor(), tags_extractor()],
+      early_exit: false,
     };
 
     let result = config.extract_and_validate(&json_data).unwrap();
@@ -105,6 +129,7 @@ mod tests {
     let config = ExtractorConfig {
       format:     DataFormat::Json,
       extractors: vec![name_extractor(), age_extractor(), active_extractor(), tags_extractor()],
+      early_exit: false,
     };
 
     let result = config.extract_and_validate(&json_data).unwrap();
@@ -149,6 +174,7 @@ mod tests {
             required: false
         ),
       ],
+      early_exit: false,
     };
 
     let result = config.extract_and_validate(&json_data).unwrap();
@@ -164,6 +190,7 @@ mod tests {
     let config = ExtractorConfig {
       format:     DataFormat::Json,
       extractors: vec![name_extractor(), age_extractor()],
+      early_exit: false,
     };
 
     // Serialize and deserialize the config
@@ -204,8 +231,11 @@ mod tests {
 
   #[test]
   fn test_extractor_config_serialization_from_string() {
-    let config =
-      ExtractorConfig { format: DataFormat::Json, extractors: vec![age_extractor()] };
+    let config = ExtractorConfig {
+      format:     DataFormat::Json,
+      extractors: vec![age_extractor()],
+      early_exit: false,
+    };
 
     // Serialize to JSON and then deserialize back
     let json_str = serde_json::to_string_pretty(&config).unwrap();
@@ -249,6 +279,31 @@ mod tests {
     assert_eq!(predicate.value, json!(18));
   }
 
+  #[test]
+  fn test_early_exit_flag_and_satisfaction() {
+    // early_exit is omitted when false so existing manifest digests are stable
+    let mut config = ExtractorConfig {
+      format:     DataFormat::Json,
+      extractors: vec![name_extractor()],
+      early_exit: false,
+    };
+    let serialized = serde_json::to_value(&config).unwrap();
+    assert!(serialized.get("early_exit").is_none());
+    assert!(!serde_json::from_value::<ExtractorConfig>(serialized).unwrap().early_exit);
+
+    config.early_exit = true;
+    let serialized = serde_json::to_value(&config).unwrap();
+    assert_eq!(serialized.get("early_exit"), Some(&json!(true)));
+
+    // Satisfied only once every required extractor resolved without errors
+    let complete = json!({"user": {"name": "John Doe"}}).to_string().into_bytes();
+    let result = config.extract_and_validate(&complete).unwrap();
+    assert!(config.is_satisfied_by(&result));
+
+    let partial = config.extract_and_validate(b"{}").unwrap();
+    assert!(!config.is_satisfied_by(&partial));
+  }
+
   #[test]
   fn test_extract_and_validate_html() {
     let html = r#"
@@ -310,6 +365,7 @@ mod tests {
             extractor_type: ExtractorType::String
         ),
       ],
+      early_exit: false,
     };
 
     let result = config.extract_and_validate(&html).unwrap();
@@ -365,6 +421,7 @@ mod tests {
             required: false
         ),
       ],
+      early_exit: false,
     };
 
     let result = config.extract_and_validate(&html).unwrap();
@@ -386,6 +443,7 @@ mod tests {
         selector:       vec!["#username".to_string()],
         extractor_type: ExtractorType::String,
       }],
+      early_exit: false,
     };
 
     // Test with non-UTF-8 bytes
@@ -396,8 +454,11 @@ mod tests {
 
   #[test]
   fn test_json_format_type_validation() {
-    let config =
-      ExtractorConfig { format: DataFormat::Json, extractors: vec![name_extractor()] };
+    let config = ExtractorConfig {
+      format:     DataFormat::Json,
+      extractors: vec![name_extractor()],
+      early_exit: false,
+    };
 
     // Test with string instead of JSON object
     let invalid_data =
@@ -1,16 +1,73 @@
+use std::{cell::RefCell, collections::HashMap};
+
 use serde_json::Value;
 use tl::{Node, NodeHandle, Parser, ParserOptions, VDom};
 
 use super::types::{DocumentExtractor, ExtractedValue, ExtractionResult, RawDocument};
 use crate::parser::{DataFormat, Extractor, ExtractorConfig, ExtractorError, ExtractorType};
 
+/// A handle over a DOM parsed exactly once per response.
+///
+/// Selector chains resolved so far are memoized keyed by selector prefix:
+/// extractors in a config frequently share chain prefixes (e.g. several
+/// extractors descending through the same `main > section.features` chain),
+/// so each prefix is evaluated against the DOM only once and later extractors
+/// continue from the cached element set.
 pub struct RawHtmlDocument<'a> {
-  dom: &'a VDom<'a>,
+  dom:               &'a VDom<'a>,
+  resolved_prefixes: RefCell<HashMap<Vec<String>, Vec<NodeHandle>>>,
+}
+
+impl<'a> RawHtmlDocument<'a> {
+  pub fn new(dom: &'a VDom<'a>) -> Self {
+    Self { dom, resolved_prefixes: RefCell::new(HashMap::new()) }
+  }
+
+  /// Resolves a selector chain against the DOM, reusing any previously
+  /// resolved prefix of the chain.
+  fn resolve_selector_chain(&self, path: &[String]) -> Result<Vec<NodeHandle>, ExtractorError> {
+    if let Some(elements) = self.resolved_prefixes.borrow().get(path) {
+      return Ok(elements.clone());
+    }
+
+    let elements = if path.len() == 1 {
+      query_selector(self.dom, &path[0], 0)?
+    } else {
+      let (last, prefix) = path.split_last().expect("path is non-empty");
+      let parents = self.resolve_selector_chain(prefix)?;
+      apply_selector_to_elements(self.dom.parser(), &parents, last, path.len() - 1)?
+    };
+
+    self.resolved_prefixes.borrow_mut().insert(path.to_vec(), elements.clone());
+    Ok(elements)
+  }
+
+  #[cfg(test)]
+  fn resolved_prefix_count(&self) -> usize { self.resolved_prefixes.borrow().len() }
+
+  /// Extracts a value for `extractor` following `selector_path`
+  fn extract_value_at(
+    &self,
+    selector_path: &[String],
+    extractor: &Extractor,
+  ) -> Result<Value, ExtractorError> {
+    if selector_path.is_empty() {
+      return Err(ExtractorError::EmptySelector);
+    }
+
+    // Handle single selector case
+    if selector_path.len() == 1 {
+      return extract_with_single_selector(self.dom, &selector_path[0], extractor);
+    }
+
+    let elements = self.resolve_selector_chain(selector_path)?;
+    process_elements(self.dom.parser(), &elements, extractor)
+  }
 }
 
 impl RawDocument for RawHtmlDocument<'_> {
   fn extract_value(&self, extractor: &Extractor) -> Result<ExtractedValue, ExtractorError> {
-    extract_html_value(self.dom, &extractor.selector, extractor).map(ExtractedValue::Html)
+    self.extract_value_at(&extractor.selector, extractor).map(ExtractedValue::Html)
   }
 
   fn validate_format(&self, format: &DataFormat) -> Result<(), ExtractorError> {
@@ -54,51 +111,31 @@ fn extract_html(
   let dom = tl::parse(html_str, ParserOptions::default())
     .map_err(|err| ExtractorError::InvalidHtml(err.to_string()))?;
 
-  let raw_html = RawHtmlDocument { dom: &dom };
+  let raw_html = RawHtmlDocument::new(&dom);
   raw_html.validate_format(&config.format)?;
 
+  // DOM traversal stays on this thread (the DOM is not shareable across
+  // threads); predicate processing of the collected values may fan out
+  let outcomes = config
+    .extractors
+    .iter()
+    .map(|extractor| (raw_html.extract_value(extractor), extractor))
+    .collect();
+
   let mut result = ExtractionResult::default();
-  for extractor in &config.extractors {
-    let value = raw_html.extract_value(extractor);
-    result.process_extraction(value, extractor);
-  }
+  result.process_extractions(outcomes);
 
   Ok(result)
 }
 
 /// Extracts a value from an HTML document using CSS selectors
+#[cfg(test)]
 fn extract_html_value(
   dom: &VDom,
   selector_path: &[String],
   extractor: &Extractor,
 ) -> Result<Value, ExtractorError> {
-  if selector_path.is_empty() {
-    return Err(ExtractorError::EmptySelector);
-  }
-
-  // Handle single selector case
-  if selector_path.len() == 1 {
-    return extract_with_single_selector(dom, &selector_path[0], extractor);
-  }
-
-  let elements: Vec<NodeHandle> = traverse_dom_with_selectors(dom, selector_path)?;
-  process_elements(dom.parser(), &elements, extractor)
-}
-
-/// Traverses the DOM using a sequence of CSS selectors
-fn traverse_dom_with_selectors(
-  dom: &VDom,
-  selector_path: &[String],
-) -> Result<Vec<NodeHandle>, ExtractorError> {
-  let first_selector = &selector_path[0];
-  let mut current_elements = query_selector(dom, first_selector, 0)?;
-  let parser = dom.parser();
-
-  for (i, selector) in selector_path.iter().enumerate().skip(1) {
-    current_elements = apply_selector_to_elements(parser, &current_elements, selector, i)?;
-  }
-
-  Ok(current_elements)
+  RawHtmlDocument::new(dom).extract_value_at(selector_path, extractor)
 }
 
 /// Queries DOM with a single selector
@@ -509,6 +546,7 @@ mod tests {
         feature_ratings_extractor(),
         first_rating_extractor(),
       ],
+      early_exit: false,
     }
   }
 
@@ -543,6 +581,30 @@ mod tests {
     assert_eq!(result.values["first_rating"], json!(4.8));
   }
 
+  #[test]
+  fn test_shared_selector_prefixes_resolved_once() {
+    let html = create_complex_test_html();
+    let dom = parse_html(&html);
+    let document = super::RawHtmlDocument::new(&dom);
+
+    // Both extractors descend through the same
+    // `main > section.features-section > div.features-grid` chain
+    let titles = document
+      .extract_value_at(&feature_titles_extractor().selector, &feature_titles_extractor())
+      .unwrap();
+    let ratings = document
+      .extract_value_at(&feature_ratings_extractor().selector, &feature_ratings_extractor())
+      .unwrap();
+
+    assert_eq!(titles.as_array().unwrap().len(), 3);
+    assert_eq!(ratings.as_array().unwrap().len(), 3);
+
+    // The cache holds one entry per distinct prefix, not one per extractor:
+    // 5 prefixes from the titles chain plus the 2 suffixes unique to the
+    // ratings chain. The 4 shared prefixes were reused, not re-queried.
+    assert_eq!(document.resolved_prefix_count(), 7);
+  }
+
   // Helper function to test extraction errors
   fn assert_html_extraction_error(
     dom: &VDom,
@@ -1,6 +1,8 @@
+use std::collections::HashMap;
+
 use serde_json::Value;
 
-use super::types::{DocumentExtractor, ExtractedValue, ExtractionResult, RawDocument};
+use super::types::{DocumentExtractor, ExtractedValue, ExtractionResult};
 use crate::parser::{errors::ExtractorError, DataFormat, Extractor, ExtractorConfig};
 
 /// Helper function to get the type of serde_json::Value as a string
@@ -15,21 +17,38 @@ pub fn get_value_type(value: &Value) -> &'static str {
   }
 }
 
-pub struct RawJsonHandle {
-  json: Value,
-}
-
-impl RawDocument for RawJsonHandle {
-  fn extract_value(&self, extractor: &Extractor) -> Result<ExtractedValue, ExtractorError> {
-    extract_json_value(&self.json, &extractor.selector).map(ExtractedValue::Json)
+/// Resolves `path` against `json` by reference, one borrowed step per
+/// segment, and returns the final node without cloning any intermediate
+/// subtree. Callers that need ownership clone only the returned node.
+pub fn extract_json_path<'a>(
+  json: &'a Value,
+  path: &[String],
+) -> Result<&'a Value, ExtractorError> {
+  if path.is_empty() {
+    return Err(ExtractorError::EmptySelector);
   }
-
-  fn validate_format(&self, format: &DataFormat) -> Result<(), ExtractorError> {
-    if *format != DataFormat::Json {
-      return Err(ExtractorError::InvalidFormat(format!("Expected JSON format, got {}", format)));
-    }
-    Ok(())
+  let mut current = json;
+  for (depth, segment) in path.iter().enumerate() {
+    current = match current {
+      Value::Object(map) => map
+        .get(segment)
+        .ok_or_else(|| ExtractorError::MissingField(format!("Key '{}' not found", segment)))?,
+      Value::Array(arr) => {
+        let index = segment.parse::<usize>().map_err(|_| ExtractorError::InvalidArrayIndex {
+          index:   segment.clone(),
+          segment: depth,
+        })?;
+        arr.get(index).ok_or(ExtractorError::ArrayIndexOutOfBounds { index, segment: depth })?
+      },
+      _ => {
+        return Err(ExtractorError::NonNavigableValue {
+          value_type: get_value_type(current).to_string(),
+          segment:    depth,
+        });
+      },
+    };
   }
+  Ok(current)
 }
 
 pub struct JsonDocumentExtractor;
@@ -52,6 +71,12 @@ impl DocumentExtractor for JsonDocumentExtractor {
     config: &ExtractorConfig,
   ) -> Result<ExtractionResult, ExtractorError> {
     let data = serde_json::from_slice::<Value>(data)?;
+    if !matches!(data, Value::Object(_) | Value::Array(_)) {
+      return Err(ExtractorError::TypeMismatch {
+        expected: "object or array".to_string(),
+        actual:   get_value_type(&data).to_string(),
+      });
+    }
     extract_json(&data, config)
   }
 }
@@ -61,54 +86,145 @@ pub fn extract_json(
   json: &Value,
   config: &ExtractorConfig,
 ) -> Result<ExtractionResult, ExtractorError> {
-  let handle = RawJsonHandle { json: json.clone() };
-  handle.validate_format(&config.format)?;
+  if config.format != DataFormat::Json {
+    return Err(ExtractorError::InvalidFormat(format!(
+      "Expected JSON format, got {}",
+      config.format
+    )));
+  }
+
+  // Compile every selector into one path trie and satisfy all extractors in a
+  // single pass over the document, instead of walking the tree once per
+  // extractor.
+  let trie = PathTrie::from_extractors(&config.extractors);
+  let outcomes = trie.walk(json);
 
   let mut result = ExtractionResult::default();
-  for extractor in &config.extractors {
-    let value = handle.extract_value(extractor);
-    result.process_extraction(value, extractor);
-  }
+  result.process_extractions(
+    outcomes
+      .into_iter()
+      .zip(&config.extractors)
+      .map(|(outcome, extractor)| (outcome.map(ExtractedValue::Json), extractor))
+      .collect(),
+  );
 
   Ok(result)
 }
 
-/// Extracts a value from a JSON object using a path selector
-fn extract_json_value(json: &Value, path: &[String]) -> Result<Value, ExtractorError> {
-  if path.is_empty() {
-    return Err(ExtractorError::EmptySelector);
+/// A trie over the selector paths of every extractor in a config.
+///
+/// Extractors in a manifest frequently share selector prefixes; merging all
+/// paths into one trie means each document node on a shared prefix is visited
+/// exactly once, so extraction cost scales with document size once rather
+/// than once per extractor.
+#[derive(Default)]
+struct PathTrie {
+  root: TrieNode,
+  /// Number of extractors the trie was built from
+  len:  usize,
+}
+
+#[derive(Default)]
+struct TrieNode {
+  /// Extractor indices whose selector path ends at this node
+  terminals:   Vec<usize>,
+  /// Child nodes keyed by the next selector segment
+  children:    HashMap<String, TrieNode>,
+  /// This node's incoming segment parsed as an array index, computed once at
+  /// build time so the walk never re-parses the segment string
+  array_index: Option<usize>,
+}
+
+impl PathTrie {
+  /// Builds a trie from the selector paths of `extractors`
+  fn from_extractors(extractors: &[Extractor]) -> Self {
+    let mut trie = PathTrie { root: TrieNode::default(), len: extractors.len() };
+    for (index, extractor) in extractors.iter().enumerate() {
+      if extractor.selector.is_empty() {
+        // Recorded during the walk as an `EmptySelector` error
+        continue;
+      }
+      let mut node = &mut trie.root;
+      for segment in &extractor.selector {
+        node = node
+          .children
+          .entry(segment.clone())
+          .or_insert_with(|| TrieNode { array_index: segment.parse().ok(), ..TrieNode::default() });
+      }
+      node.terminals.push(index);
+    }
+    trie
   }
 
-  let mut current = json;
+  /// Walks the document once, resolving every extractor's selector path.
+  /// Returns one outcome per extractor, in extractor order.
+  fn walk(&self, json: &Value) -> Vec<Result<Value, ExtractorError>> {
+    let mut outcomes: Vec<Result<Value, ExtractorError>> =
+      (0..self.len).map(|_| Err(ExtractorError::EmptySelector)).collect();
+    Self::walk_node(&self.root, json, 0, &mut outcomes);
+    outcomes
+  }
 
-  for (i, segment) in path.iter().enumerate() {
-    match current {
-      Value::Object(map) =>
-        if let Some(value) = map.get(segment) {
-          current = value;
-        } else {
-          return Err(ExtractorError::MissingField(format!("Key '{}' not found", segment)));
-        },
-      Value::Array(arr) =>
-        if let Ok(index) = segment.parse::<usize>() {
-          if index < arr.len() {
-            current = &arr[index];
+  /// Visits `node` positioned at `value`, descending into each child segment
+  fn walk_node(
+    node: &TrieNode,
+    value: &Value,
+    depth: usize,
+    outcomes: &mut Vec<Result<Value, ExtractorError>>,
+  ) {
+    for &index in &node.terminals {
+      outcomes[index] = Ok(value.clone());
+    }
+
+    for (segment, child) in &node.children {
+      match value {
+        Value::Object(map) =>
+          if let Some(next) = map.get(segment) {
+            Self::walk_node(child, next, depth + 1, outcomes);
           } else {
-            return Err(ExtractorError::ArrayIndexOutOfBounds { index, segment: i });
-          }
-        } else {
-          return Err(ExtractorError::InvalidArrayIndex { index: segment.clone(), segment: i });
+            Self::fail_subtree(child, outcomes, || {
+              ExtractorError::MissingField(format!("Key '{}' not found", segment))
+            });
+          },
+        Value::Array(arr) =>
+          if let Some(index) = child.array_index {
+            if index < arr.len() {
+              Self::walk_node(child, &arr[index], depth + 1, outcomes);
+            } else {
+              Self::fail_subtree(child, outcomes, || ExtractorError::ArrayIndexOutOfBounds {
+                index,
+                segment: depth,
+              });
+            }
+          } else {
+            Self::fail_subtree(child, outcomes, || ExtractorError::InvalidArrayIndex {
+              index:   segment.clone(),
+              segment: depth,
+            });
+          },
+        _ => {
+          Self::fail_subtree(child, outcomes, || ExtractorError::NonNavigableValue {
+            value_type: get_value_type(value).to_string(),
+            segment:    depth,
+          });
         },
-      _ => {
-        return Err(ExtractorError::NonNavigableValue {
-          value_type: get_value_type(current).to_string(),
-          segment:    i,
-        });
-      },
+      }
     }
   }
 
-  Ok(current.clone())
+  /// Records `error` for every extractor terminating in or below `node`
+  fn fail_subtree(
+    node: &TrieNode,
+    outcomes: &mut Vec<Result<Value, ExtractorError>>,
+    error: impl Fn() -> ExtractorError + Copy,
+  ) {
+    for &index in &node.terminals {
+      outcomes[index] = Err(error());
+    }
+    for child in node.children.values() {
+      Self::fail_subtree(child, outcomes, error);
+    }
+  }
 }
 
 #[cfg(test)]
@@ -346,6 +462,79 @@ mod tests {
     }
   }
 
+  mod shared_prefixes {
+    use super::*;
+    use crate::parser::ExtractorType;
+
+    #[test]
+    fn extractors_sharing_path_prefixes_resolve_in_one_pass() {
+      let json_data = json!({
+        "user": {
+          "profile": {
+            "name": "John Doe",
+            "age": 30
+          },
+          "tags": ["developer", "rust"]
+        }
+      })
+      .to_string()
+      .into_bytes();
+
+      let config = create_json_config(vec![
+        extractor!(
+          id: "name".to_string(),
+          selector: vec!["user".to_string(), "profile".to_string(), "name".to_string()],
+          extractor_type: ExtractorType::String
+        ),
+        extractor!(
+          id: "age".to_string(),
+          selector: vec!["user".to_string(), "profile".to_string(), "age".to_string()],
+          extractor_type: ExtractorType::Number
+        ),
+        extractor!(
+          id: "first_tag".to_string(),
+          selector: vec!["user".to_string(), "tags".to_string(), "0".to_string()],
+          extractor_type: ExtractorType::String
+        ),
+        // Duplicate selector: both extractors must be satisfied
+        extractor!(
+          id: "name_again".to_string(),
+          selector: vec!["user".to_string(), "profile".to_string(), "name".to_string()],
+          extractor_type: ExtractorType::String
+        ),
+      ]);
+
+      let result = config.extract_and_validate(&json_data).unwrap();
+      assert_extraction_success(&result, &[
+        ("name", &json!("John Doe")),
+        ("age", &json!(30)),
+        ("first_tag", &json!("developer")),
+        ("name_again", &json!("John Doe")),
+      ]);
+    }
+
+    #[test]
+    fn failure_on_shared_prefix_reports_every_dependent_extractor() {
+      let json_data = json!({ "other": {} }).to_string().into_bytes();
+
+      let config = create_json_config(vec![
+        extractor!(
+          id: "a".to_string(),
+          selector: vec!["user".to_string(), "name".to_string()],
+          extractor_type: ExtractorType::String
+        ),
+        extractor!(
+          id: "b".to_string(),
+          selector: vec!["user".to_string(), "age".to_string()],
+          extractor_type: ExtractorType::Number
+        ),
+      ]);
+
+      let result = config.extract_and_validate(&json_data).unwrap();
+      assert_extraction_error(&result, 2, &["Key 'user' not found"]);
+    }
+  }
+
   mod edge_cases {
     use super::*;
 
@@ -404,6 +593,47 @@ mod tests {
     }
   }
 
+  mod borrowed_traversal {
+    use serde_json::json;
+
+    use crate::parser::{extract_json_path, ExtractorError};
+
+    #[test]
+    fn returns_references_into_the_document() {
+      let document = json!({
+        "items": [
+          { "price": 10 },
+          { "price": 20 }
+        ]
+      });
+
+      let path = vec!["items".to_string(), "1".to_string(), "price".to_string()];
+      let node = extract_json_path(&document, &path).unwrap();
+      // The returned node is a borrow into `document`, not a copy
+      assert!(std::ptr::eq(node, &document["items"][1]["price"]));
+      assert_eq!(node, &json!(20));
+    }
+
+    #[test]
+    fn reports_the_same_errors_as_extraction() {
+      let document = json!({ "items": [1, 2] });
+
+      assert!(matches!(extract_json_path(&document, &[]), Err(ExtractorError::EmptySelector)));
+      assert!(matches!(
+        extract_json_path(&document, &["missing".to_string()]),
+        Err(ExtractorError::MissingField(_))
+      ));
+      assert!(matches!(
+        extract_json_path(&document, &["items".to_string(), "7".to_string()]),
+        Err(ExtractorError::ArrayIndexOutOfBounds { index: 7, segment: 1 })
+      ));
+      assert!(matches!(
+        extract_json_path(&document, &["items".to_string(), "x".to_string()]),
+        Err(ExtractorError::InvalidArrayIndex { .. })
+      ));
+    }
+  }
+
   #[test]
   fn test_nesting_depth() {
     // Test different nesting depths
@@ -3,5 +3,5 @@ mod json;
 mod types;
 
 pub use html::HtmlDocumentExtractor;
-pub use json::{get_value_type, JsonDocumentExtractor};
+pub use json::{extract_json_path, get_value_type, JsonDocumentExtractor};
 pub use types::{DocumentExtractor, ExtractionResult, ExtractionValues, Extractor, ExtractorType};
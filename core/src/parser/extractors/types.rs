@@ -4,14 +4,17 @@
 
 use std::{collections::HashMap, fmt::Display};
 
+use rayon::prelude::*;
 use serde::{Deserialize, Serialize};
 use serde_json::Value;
 use tracing::debug;
 
 use crate::{
-  hash::keccak_digest,
+  hash::IncrementalKeccak,
   parser::{
-    errors::ExtractorErrorWithId, extractors::get_value_type, predicate, predicate::Predicate,
+    errors::ExtractorErrorWithId,
+    extractors::get_value_type,
+    predicate::{CompiledPredicateCache, Predicate},
     DataFormat, ExtractorConfig, ExtractorError,
   },
 };
@@ -95,29 +98,39 @@ fn default_true() -> bool { true }
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
 pub struct Extractor {
   /// Unique identifier for the extractor
-  pub id:             String,
+  pub id:                  String,
   /// Human-readable description
-  pub description:    String,
+  pub description:         String,
   /// Path to the data (e.g., JSON path)
-  pub selector:       Vec<String>,
+  pub selector:            Vec<String>,
   /// Expected data type
   #[serde(rename = "type")]
-  pub extractor_type: ExtractorType,
+  pub extractor_type:      ExtractorType,
   /// Whether this extraction is required
   #[serde(default = "default_true")]
-  pub required:       bool,
+  pub required:            bool,
   /// Predicates to validate the extracted data
   #[serde(default)]
-  pub predicates:     Vec<Predicate>,
+  pub predicates:          Vec<Predicate>,
   /// HTML attribute to extract
   #[serde(skip_serializing_if = "Option::is_none")]
-  pub attribute:      Option<String>,
+  pub attribute:           Option<String>,
+  /// Evaluation plans compiled from `predicates`, built once and reused for
+  /// every value this extractor validates. Derived state: skipped by serde,
+  /// so it never affects the manifest wire format or digest.
+  #[serde(skip)]
+  pub compiled_predicates: CompiledPredicateCache,
 }
 
 /// The extracted values, keyed by extractor ID
 // TODO: Consider supporting lazy evaluation https://github.com/pluto/web-prover/pull/547#discussion_r1986223169
 pub type ExtractionValues = HashMap<String, Value>;
 
+/// Minimum number of extractors before processing fans out across the rayon
+/// pool. Small configs keep the cheap sequential path; the crossover is
+/// dominated by predicate (especially regex) evaluation cost per extractor.
+const PARALLEL_EXTRACTOR_THRESHOLD: usize = 8;
+
 /// The result of an extraction operation
 #[derive(Debug, Clone, Default, Serialize, Deserialize, PartialEq)]
 pub struct ExtractionResult {
@@ -148,8 +161,8 @@ impl ExtractionResult {
         }
 
         let mut predicate_valid = true;
-        for predicate in &extractor.predicates {
-          if let Err(pred_err) = predicate::validate_predicate(&value, predicate) {
+        for plan in extractor.compiled_predicates.get_or_compile(&extractor.predicates) {
+          if let Err(pred_err) = plan.evaluate(&value) {
             if extractor.required {
               self.add_extractor_error(extractor, ExtractorError::PredicateError(pred_err));
             }
@@ -172,6 +185,37 @@ impl ExtractionResult {
     }
   }
 
+  /// Processes a batch of extraction outcomes, one per extractor.
+  ///
+  /// Large configs fan the per-extractor work (type check plus predicate
+  /// evaluation) out across the rayon pool and merge the partial results back
+  /// in extractor order, so values and error messages come out identical to
+  /// the sequential path. Document traversal itself stays with the caller —
+  /// the HTML DOM is not shareable across threads.
+  pub fn process_extractions(
+    &mut self,
+    outcomes: Vec<(Result<ExtractedValue, ExtractorError>, &Extractor)>,
+  ) {
+    if outcomes.len() < PARALLEL_EXTRACTOR_THRESHOLD {
+      for (outcome, extractor) in outcomes {
+        self.process_extraction(outcome, extractor);
+      }
+      return;
+    }
+
+    let partials: Vec<ExtractionResult> = outcomes
+      .into_par_iter()
+      .map(|(outcome, extractor)| {
+        let mut partial = ExtractionResult::default();
+        partial.process_extraction(outcome, extractor);
+        partial
+      })
+      .collect();
+    for partial in partials {
+      self.merge(partial);
+    }
+  }
+
   /// Adds an error to the result and logs it
   pub fn report_error(&mut self, error: ExtractorErrorWithId) {
     tracing::debug!(
@@ -195,10 +239,11 @@ impl ExtractionResult {
     self.report_error((extractor.id.clone(), error).into());
   }
 
-  /// Merges another extraction result into this one
-  pub fn merge(&mut self, other: &ExtractionResult) {
-    self.values.extend(other.clone().values);
-    self.errors.extend(other.clone().errors);
+  /// Merges another extraction result into this one, taking ownership so the
+  /// extracted values and error strings move instead of being cloned
+  pub fn merge(&mut self, other: ExtractionResult) {
+    self.values.extend(other.values);
+    self.errors.extend(other.errors);
   }
 
   /// Returns `true` if no errors were encountered during extraction
@@ -206,8 +251,11 @@ impl ExtractionResult {
 
   /// Compute a `Keccak256` hash of the serialized ExtractionResult
   pub fn to_keccak_digest(&self) -> Result<[u8; 32], ExtractorError> {
-    let as_bytes: Vec<u8> = serde_json::to_vec(self)?;
-    Ok(keccak_digest(&as_bytes))
+    // Serialize straight into the hash state instead of materializing the
+    // JSON bytes; the digest is identical to hashing `serde_json::to_vec`
+    let mut hasher = IncrementalKeccak::new();
+    serde_json::to_writer(&mut hasher, self)?;
+    Ok(hasher.finalize())
   }
 }
 
@@ -230,3 +278,59 @@ pub trait RawDocument {
   fn extract_value(&self, extractor: &Extractor) -> Result<ExtractedValue, ExtractorError>;
   fn validate_format(&self, format: &DataFormat) -> Result<(), ExtractorError>;
 }
+
+#[cfg(test)]
+mod tests {
+  use serde_json::json;
+
+  use super::*;
+
+  fn numbered_extractor(index: usize) -> Extractor {
+    Extractor {
+      id:                  format!("extractor_{}", index),
+      description:         format!("Extractor {}", index),
+      selector:            vec![format!("field_{}", index)],
+      extractor_type:      ExtractorType::Number,
+      required:            true,
+      predicates:          vec![],
+      attribute:           None,
+      compiled_predicates: Default::default(),
+    }
+  }
+
+  #[test]
+  fn test_process_extractions_parallel_matches_sequential() {
+    // Enough extractors to cross PARALLEL_EXTRACTOR_THRESHOLD, with a mix of
+    // successes, type mismatches, and extraction failures
+    let extractors: Vec<Extractor> =
+      (0..PARALLEL_EXTRACTOR_THRESHOLD + 4).map(numbered_extractor).collect();
+    fn outcomes(
+      extractors: &[Extractor],
+    ) -> Vec<(Result<ExtractedValue, ExtractorError>, &Extractor)> {
+      extractors
+        .iter()
+        .enumerate()
+        .map(|(i, extractor)| {
+          let outcome = match i % 3 {
+            0 => Ok(ExtractedValue::Json(json!(i))),
+            1 => Ok(ExtractedValue::Json(json!("not a number"))),
+            _ => Err(ExtractorError::MissingField(format!("field_{}", i))),
+          };
+          (outcome, extractor)
+        })
+        .collect::<Vec<_>>()
+    }
+
+    let mut parallel = ExtractionResult::default();
+    parallel.process_extractions(outcomes(&extractors));
+
+    let mut sequential = ExtractionResult::default();
+    for (outcome, extractor) in outcomes(&extractors) {
+      sequential.process_extraction(outcome, extractor);
+    }
+
+    assert_eq!(parallel, sequential);
+    assert!(!parallel.values.is_empty());
+    assert!(!parallel.errors.is_empty());
+  }
+}
@@ -7,8 +7,12 @@ mod extractors;
 #[cfg(test)] mod test_utils;
 
 pub use config::{DataFormat, ExtractorConfig};
-pub use errors::ExtractorError;
+pub use errors::{ExtractorError, PredicateError};
 pub use extractors::{
-  DocumentExtractor, ExtractionResult, ExtractionValues, Extractor, ExtractorType,
-  HtmlDocumentExtractor, JsonDocumentExtractor,
+  extract_json_path, DocumentExtractor, ExtractionResult, ExtractionValues, Extractor,
+  ExtractorType, HtmlDocumentExtractor, JsonDocumentExtractor,
+};
+pub use predicate::{
+  validate_predicate, Comparison, CompiledPredicate, CompiledPredicateCache, Predicate,
+  PredicateType,
 };
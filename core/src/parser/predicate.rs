@@ -1,8 +1,66 @@
+use std::{
+  collections::HashMap,
+  fmt,
+  sync::{Arc, OnceLock, RwLock},
+};
+
 use serde::{Deserialize, Serialize};
 use serde_json::Value;
 
 use crate::parser::{errors::PredicateError, extractors::get_value_type};
 
+/// Process-wide store of compiled regexes, keyed by pattern and flags.
+///
+/// Manifests reuse the same handful of patterns across thousands of
+/// notarizations, so each pattern is compiled exactly once and the hot path in
+/// [`validate_regex_predicate`] only ever executes pre-built automata.
+static REGEX_STORE: OnceLock<RwLock<HashMap<(String, Option<String>), Arc<regex::Regex>>>> =
+  OnceLock::new();
+
+/// Safety valve against unbounded growth: patterns come from
+/// attacker-controlled manifests, so past this point the store is assumed to
+/// be fed garbage and dropping it is the cheapest way to recover. Live
+/// `Arc`s handed out earlier stay valid; evicted patterns just recompile on
+/// next use.
+const MAX_CACHED_REGEXES: usize = 1024;
+
+/// Returns the compiled regex for `pattern` with the given flags, compiling
+/// and caching it on first use.
+fn compiled_regex(pattern: &str, flags: Option<&str>) -> Result<Arc<regex::Regex>, PredicateError> {
+  let store = REGEX_STORE.get_or_init(Default::default);
+  let key = (pattern.to_string(), flags.map(str::to_string));
+
+  if let Some(regex) = store.read().unwrap().get(&key) {
+    return Ok(regex.clone());
+  }
+
+  // Build regex with flags if provided
+  let regex_result = if let Some(flags) = flags {
+    let mut builder = regex::RegexBuilder::new(pattern);
+
+    if flags.contains('i') {
+      builder.case_insensitive(true);
+    }
+    if flags.contains('m') {
+      builder.multi_line(true);
+    }
+    if flags.contains('s') {
+      builder.dot_matches_new_line(true);
+    }
+
+    builder.build()
+  } else {
+    regex::Regex::new(pattern)
+  };
+
+  let regex = Arc::new(regex_result.map_err(|e| PredicateError::RegexError(e.to_string()))?);
+  let mut cache = store.write().unwrap();
+  if cache.len() >= MAX_CACHED_REGEXES {
+    cache.clear();
+  }
+  Ok(cache.entry(key).or_insert(regex).clone())
+}
+
 /// The type of predicate to apply
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq, Copy)]
 #[serde(rename_all = "camelCase")]
@@ -358,31 +416,7 @@ pub fn validate_regex_predicate(
     },
   };
 
-  // Build regex with flags if provided
-  let regex_result = if let Some(flags) = &predicate.flags {
-    let mut builder = regex::RegexBuilder::new(pattern);
-
-    if flags.contains('i') {
-      builder.case_insensitive(true);
-    }
-    if flags.contains('m') {
-      builder.multi_line(true);
-    }
-    if flags.contains('s') {
-      builder.dot_matches_new_line(true);
-    }
-
-    builder.build()
-  } else {
-    regex::Regex::new(pattern)
-  };
-
-  let regex = match regex_result {
-    Ok(r) => r,
-    Err(e) => {
-      return Err(PredicateError::RegexError(e.to_string()));
-    },
-  };
+  let regex = compiled_regex(pattern, predicate.flags.as_deref())?;
 
   let matches = regex.is_match(string_value);
 
@@ -547,6 +581,341 @@ pub fn validate_predicate(value: &Value, predicate: &Predicate) -> Result<(), Pr
   }
 }
 
+/// Which predicate family an affix check was compiled from; the families
+/// report different errors for non-string inputs.
+#[derive(Debug, Clone, Copy)]
+pub enum AffixSource {
+  Value,
+  String,
+}
+
+/// A predicate compiled into a direct evaluation plan.
+///
+/// A manifest fixes its predicates once, but [`validate_predicate`]
+/// re-dispatches on the type and comparison enums and re-validates the
+/// predicate's own configuration (expected-length parse, regex lookup,
+/// lowercasing the affix) on every evaluation. Compiling resolves all of
+/// that up front, so evaluating against an extracted value is a single
+/// match on pre-typed operands. Configurations that cannot be resolved
+/// statically — including ones whose errors must surface at evaluation
+/// time, and the array `every`/`some` forms — fall back to the interpreted
+/// path and report exactly the same errors.
+#[derive(Debug, Clone)]
+pub enum CompiledPredicate {
+  /// Equality (or inequality) against a fixed expected value, with the
+  /// epsilon semantics for numeric pairs
+  Equal { expected: Value, negate: bool },
+  /// Ordering against a fixed expected value; the numeric form of the
+  /// expected value is converted once at compile time
+  Order { expected: Value, expected_num: Option<f64>, comparison: Comparison },
+  /// Substring or array containment
+  Contains { expected: Value, negate: bool },
+  /// String prefix/suffix check, with the lowercase form precomputed for
+  /// case-insensitive mode
+  Affix {
+    affix:          String,
+    affix_lower:    String,
+    case_sensitive: bool,
+    ends:           bool,
+    source:         AffixSource,
+  },
+  /// Length comparison with the expected length parsed once
+  Length { expected: usize, comparison: Comparison },
+  /// Regex match with the automaton resolved once
+  Regex { regex: Arc<regex::Regex>, pattern: String, negate: bool },
+  /// Array containment
+  Includes { expected: Value },
+  /// Interpreted fallback via [`validate_predicate`]
+  Fallback(Predicate),
+}
+
+impl CompiledPredicate {
+  /// Compiles `predicate` into its evaluation plan. Never fails: statically
+  /// invalid configurations compile to the fallback plan so their errors
+  /// surface at evaluation time, exactly as in the interpreted path.
+  pub fn compile(predicate: &Predicate) -> Self {
+    match (predicate.predicate_type, predicate.comparison) {
+      (PredicateType::Value, Comparison::Equal) =>
+        CompiledPredicate::Equal { expected: predicate.value.clone(), negate: false },
+      (PredicateType::Value, Comparison::NotEqual) =>
+        CompiledPredicate::Equal { expected: predicate.value.clone(), negate: true },
+      (
+        PredicateType::Value,
+        Comparison::GreaterThan
+        | Comparison::LessThan
+        | Comparison::GreaterThanOrEqual
+        | Comparison::LessThanOrEqual,
+      ) => CompiledPredicate::Order {
+        expected:     predicate.value.clone(),
+        expected_num: predicate.value.as_f64(),
+        comparison:   predicate.comparison,
+      },
+      (PredicateType::Value, Comparison::Contains) =>
+        CompiledPredicate::Contains { expected: predicate.value.clone(), negate: false },
+      (PredicateType::Value, Comparison::NotContains) =>
+        CompiledPredicate::Contains { expected: predicate.value.clone(), negate: true },
+      (PredicateType::Value, Comparison::StartsWith | Comparison::EndsWith) =>
+        match predicate.value.as_str() {
+          Some(affix) => CompiledPredicate::Affix {
+            affix:          affix.to_string(),
+            affix_lower:    affix.to_lowercase(),
+            case_sensitive: predicate.case_sensitive,
+            ends:           predicate.comparison == Comparison::EndsWith,
+            source:         AffixSource::Value,
+          },
+          None => CompiledPredicate::Fallback(predicate.clone()),
+        },
+      (PredicateType::String, Comparison::StartsWith | Comparison::EndsWith) =>
+        match predicate.value.as_str() {
+          Some(affix) => CompiledPredicate::Affix {
+            affix:          affix.to_string(),
+            affix_lower:    affix.to_lowercase(),
+            case_sensitive: predicate.case_sensitive,
+            ends:           predicate.comparison == Comparison::EndsWith,
+            source:         AffixSource::String,
+          },
+          None => CompiledPredicate::Fallback(predicate.clone()),
+        },
+      (
+        PredicateType::Length,
+        Comparison::Equal
+        | Comparison::NotEqual
+        | Comparison::GreaterThan
+        | Comparison::LessThan
+        | Comparison::GreaterThanOrEqual
+        | Comparison::LessThanOrEqual,
+      ) => match predicate.value.as_u64() {
+        Some(expected) => CompiledPredicate::Length {
+          expected:   expected as usize,
+          comparison: predicate.comparison,
+        },
+        None => CompiledPredicate::Fallback(predicate.clone()),
+      },
+      (
+        PredicateType::Regex,
+        Comparison::Equal | Comparison::Contains | Comparison::NotEqual | Comparison::NotContains,
+      ) => {
+        let Some(pattern) = predicate.value.as_str() else {
+          return CompiledPredicate::Fallback(predicate.clone());
+        };
+        match compiled_regex(pattern, predicate.flags.as_deref()) {
+          Ok(regex) => CompiledPredicate::Regex {
+            regex,
+            pattern: pattern.to_string(),
+            negate: matches!(predicate.comparison, Comparison::NotEqual | Comparison::NotContains),
+          },
+          Err(_) => CompiledPredicate::Fallback(predicate.clone()),
+        }
+      },
+      (PredicateType::Array, Comparison::Includes) =>
+        CompiledPredicate::Includes { expected: predicate.value.clone() },
+      // Everything else — the array every/some forms (which carry nested
+      // semantics) and statically invalid combinations — stays interpreted
+      _ => CompiledPredicate::Fallback(predicate.clone()),
+    }
+  }
+
+  /// Evaluates the plan against `value`, reporting the same errors as
+  /// [`validate_predicate`] on the equivalent predicate.
+  pub fn evaluate(&self, value: &Value) -> Result<(), PredicateError> {
+    match self {
+      CompiledPredicate::Equal { expected, negate } => {
+        let matches = match (value, expected) {
+          (Value::Number(_), Value::Number(_)) =>
+            compare_values(value, expected, |a, b| (a - b).abs() < f64::EPSILON, |a, b| a == b),
+          _ => value == expected,
+        };
+        match (matches, negate) {
+          (true, true) =>
+            Err(PredicateError::Equal { actual: value.clone(), expected: expected.clone() }),
+          (false, false) =>
+            Err(PredicateError::NotEqual { actual: value.clone(), expected: expected.clone() }),
+          _ => Ok(()),
+        }
+      },
+      CompiledPredicate::Order { expected, expected_num, comparison } => {
+        // Fast path: both sides numeric, expected converted at compile time
+        let (greater, less) = match (value.as_f64(), expected_num) {
+          (Some(actual), Some(expected)) => (actual > *expected, actual < *expected),
+          _ => (is_greater_than(value, expected), is_less_than(value, expected)),
+        };
+        match comparison {
+          Comparison::GreaterThan if !greater => Err(PredicateError::NotGreaterThan {
+            actual:   value.clone(),
+            expected: expected.clone(),
+          }),
+          Comparison::LessThan if !less =>
+            Err(PredicateError::NotLessThan { actual: value.clone(), expected: expected.clone() }),
+          Comparison::GreaterThanOrEqual if less =>
+            Err(PredicateError::LessThan { actual: value.clone(), expected: expected.clone() }),
+          Comparison::LessThanOrEqual if greater =>
+            Err(PredicateError::GreaterThan { actual: value.clone(), expected: expected.clone() }),
+          _ => Ok(()),
+        }
+      },
+      CompiledPredicate::Contains { expected, negate } => match (value, expected) {
+        (Value::String(s), Value::String(pattern)) => match (s.contains(pattern), negate) {
+          (true, true) =>
+            Err(PredicateError::StringContains { string: s.clone(), pattern: pattern.clone() }),
+          (false, false) =>
+            Err(PredicateError::StringNotContains { string: s.clone(), pattern: pattern.clone() }),
+          _ => Ok(()),
+        },
+        (Value::Array(arr), val) => match (arr.contains(val), negate) {
+          (true, true) =>
+            Err(PredicateError::ArrayContains { array: arr.clone(), value: val.clone() }),
+          (false, false) =>
+            Err(PredicateError::ArrayNotIncludes { array: arr.clone(), value: val.clone() }),
+          _ => Ok(()),
+        },
+        _ => Err(PredicateError::InvalidComparison {
+          comparison:    if *negate { Comparison::NotContains } else { Comparison::Contains },
+          actual_type:   get_value_type(value).to_string(),
+          expected_type: get_value_type(expected).to_string(),
+        }),
+      },
+      CompiledPredicate::Affix { affix, affix_lower, case_sensitive, ends, source } => {
+        let comparison = if *ends { Comparison::EndsWith } else { Comparison::StartsWith };
+        let s = match value {
+          Value::String(s) => s,
+          _ =>
+            return Err(match source {
+              AffixSource::Value => PredicateError::InvalidComparison {
+                comparison,
+                actual_type: get_value_type(value).to_string(),
+                expected_type: "string".to_string(),
+              },
+              AffixSource::String =>
+                PredicateError::StringPredicateNotApplicable(get_value_type(value).to_string()),
+            }),
+        };
+        let holds = if *case_sensitive {
+          if *ends {
+            s.ends_with(affix)
+          } else {
+            s.starts_with(affix)
+          }
+        } else {
+          let lower = s.to_lowercase();
+          if *ends {
+            lower.ends_with(affix_lower)
+          } else {
+            lower.starts_with(affix_lower)
+          }
+        };
+        if holds {
+          Ok(())
+        } else if *ends {
+          Err(PredicateError::StringNotEndsWith {
+            string:         s.clone(),
+            suffix:         affix.clone(),
+            case_sensitive: *case_sensitive,
+          })
+        } else {
+          Err(PredicateError::StringNotStartsWith {
+            string:         s.clone(),
+            prefix:         affix.clone(),
+            case_sensitive: *case_sensitive,
+          })
+        }
+      },
+      CompiledPredicate::Length { expected, comparison } => {
+        let length = match value {
+          Value::String(s) => s.len(),
+          Value::Array(arr) => arr.len(),
+          Value::Object(obj) => obj.len(),
+          _ =>
+            return Err(PredicateError::InvalidPredicateForType {
+              predicate_type: PredicateType::Length,
+              value_type:     get_value_type(value).to_string(),
+            }),
+        };
+        match comparison {
+          Comparison::Equal if length != *expected =>
+            Err(PredicateError::LengthNotEqual { actual: length, expected: *expected }),
+          Comparison::NotEqual if length == *expected =>
+            Err(PredicateError::LengthEqual { actual: length, expected: *expected }),
+          Comparison::GreaterThan if length <= *expected =>
+            Err(PredicateError::LengthNotGreaterThan { actual: length, expected: *expected }),
+          Comparison::LessThan if length >= *expected =>
+            Err(PredicateError::LengthNotLessThan { actual: length, expected: *expected }),
+          Comparison::GreaterThanOrEqual if length < *expected =>
+            Err(PredicateError::LengthLessThan { actual: length, expected: *expected }),
+          Comparison::LessThanOrEqual if length > *expected =>
+            Err(PredicateError::LengthGreaterThan { actual: length, expected: *expected }),
+          _ => Ok(()),
+        }
+      },
+      CompiledPredicate::Regex { regex, pattern, negate } => {
+        let string_value = match value {
+          Value::String(s) => s,
+          _ => return Err(PredicateError::RegexNotApplicable(get_value_type(value).to_string())),
+        };
+        match (regex.is_match(string_value), negate) {
+          (true, true) => Err(PredicateError::RegexMatch {
+            string:  string_value.to_string(),
+            pattern: pattern.clone(),
+          }),
+          (false, false) => Err(PredicateError::RegexNoMatch {
+            string:  string_value.to_string(),
+            pattern: pattern.clone(),
+          }),
+          _ => Ok(()),
+        }
+      },
+      CompiledPredicate::Includes { expected } => {
+        let array_value = match value {
+          Value::Array(arr) => arr,
+          _ =>
+            return Err(PredicateError::ArrayPredicateNotApplicable(
+              get_value_type(value).to_string(),
+            )),
+        };
+        if array_value.contains(expected) {
+          Ok(())
+        } else {
+          Err(PredicateError::ArrayNotIncludes {
+            array: array_value.clone(),
+            value: expected.clone(),
+          })
+        }
+      },
+      CompiledPredicate::Fallback(predicate) => validate_predicate(value, predicate),
+    }
+  }
+}
+
+/// Lazily compiled evaluation plans for an extractor's predicates.
+///
+/// Lives on [`Extractor`](crate::parser::extractors::Extractor) behind
+/// `#[serde(skip)]`: compiled once per (registry-cached) manifest and
+/// invisible to the wire format, equality, and the manifest digest.
+#[derive(Default)]
+pub struct CompiledPredicateCache(OnceLock<Vec<CompiledPredicate>>);
+
+impl CompiledPredicateCache {
+  /// Returns the compiled plans for `predicates`, compiling them on first use.
+  pub fn get_or_compile(&self, predicates: &[Predicate]) -> &[CompiledPredicate] {
+    self.0.get_or_init(|| predicates.iter().map(CompiledPredicate::compile).collect())
+  }
+}
+
+// The cache is derived state: clones start empty and recompile on first use,
+// and it never participates in equality.
+impl Clone for CompiledPredicateCache {
+  fn clone(&self) -> Self { Self::default() }
+}
+
+impl PartialEq for CompiledPredicateCache {
+  fn eq(&self, _other: &Self) -> bool { true }
+}
+
+impl fmt::Debug for CompiledPredicateCache {
+  fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+    f.debug_struct("CompiledPredicateCache").finish_non_exhaustive()
+  }
+}
+
 /// Helper function to compare two `Value` objects with given numeric and string comparators
 fn compare_values<FNum, FStr>(
   a: &Value,
@@ -790,6 +1159,20 @@ mod tests {
     assert!(validate_length_predicate(&json_data["empty_array"], &predicate).is_ok());
   }
 
+  #[test]
+  fn test_regex_store_reuses_compiled_patterns() {
+    let first = compiled_regex(r"^store-test-[0-9]+$", None).unwrap();
+    let second = compiled_regex(r"^store-test-[0-9]+$", None).unwrap();
+    assert!(Arc::ptr_eq(&first, &second));
+
+    // Same pattern with different flags compiles to a distinct entry
+    let flagged = compiled_regex(r"^store-test-[0-9]+$", Some("i")).unwrap();
+    assert!(!Arc::ptr_eq(&first, &flagged));
+
+    // Invalid patterns surface the usual error and are not cached
+    assert!(compiled_regex(r"[invalid(", None).is_err());
+  }
+
   #[test]
   fn test_numeric_comparisons() {
     let test_cases = vec![
@@ -1025,4 +1408,74 @@ mod tests {
     );
     assert!(validate_value_predicate(&json_data["almost_same"], &predicate).is_ok());
   }
+
+  #[test]
+  fn test_compiled_predicates_match_interpreted() {
+    // Every (predicate, value) pair an evaluation can see — valid and
+    // misconfigured — must produce the same outcome and the same error
+    // message through the compiled plan as through validate_predicate
+    let predicates = vec![
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::Equal, value: json!(42)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::NotEqual, value: json!(42)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::GreaterThan, value: json!(10)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::LessThan, value: json!(10)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::GreaterThanOrEqual, value: json!(42)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::LessThanOrEqual, value: json!(42)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::GreaterThan, value: json!("m")),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::Contains, value: json!("world")),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::NotContains, value: json!("world")),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::Contains, value: json!(2)),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::StartsWith, value: json!("hello")),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::StartsWith, value: json!("HELLO"), case_sensitive: false),
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::EndsWith, value: json!("world")),
+      // Misconfigured: non-string affix compiles to the fallback plan
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::StartsWith, value: json!(42)),
+      // Misrouted: handled by the array validator in both paths
+      predicate!(predicate_type: PredicateType::Value, comparison: Comparison::Includes, value: json!(1)),
+      predicate!(predicate_type: PredicateType::Length, comparison: Comparison::Equal, value: json!(11)),
+      predicate!(predicate_type: PredicateType::Length, comparison: Comparison::GreaterThan, value: json!(3)),
+      predicate!(predicate_type: PredicateType::Length, comparison: Comparison::LessThanOrEqual, value: json!(2)),
+      // Misconfigured: non-numeric expected length
+      predicate!(predicate_type: PredicateType::Length, comparison: Comparison::Equal, value: json!("long")),
+      predicate!(predicate_type: PredicateType::Regex, comparison: Comparison::Equal, value: json!("^hello")),
+      predicate!(predicate_type: PredicateType::Regex, comparison: Comparison::NotContains, value: json!("\\d{5}")),
+      predicate!(predicate_type: PredicateType::Regex, comparison: Comparison::Equal, value: json!("^HELLO"), flags: Some("i".to_string())),
+      // Misconfigured: invalid pattern compiles to the fallback plan
+      predicate!(predicate_type: PredicateType::Regex, comparison: Comparison::Equal, value: json!("[unclosed")),
+      predicate!(predicate_type: PredicateType::String, comparison: Comparison::StartsWith, value: json!("hello")),
+      predicate!(predicate_type: PredicateType::String, comparison: Comparison::EndsWith, value: json!("WORLD"), case_sensitive: false),
+      // Misconfigured: string predicate with a non-affix comparison
+      predicate!(predicate_type: PredicateType::String, comparison: Comparison::Contains, value: json!("hello")),
+      predicate!(predicate_type: PredicateType::Array, comparison: Comparison::Includes, value: json!(2)),
+      // Every/Some stay on the interpreted path (nested semantics)
+      predicate!(predicate_type: PredicateType::Array, comparison: Comparison::Every, value: json!(0)),
+      predicate!(predicate_type: PredicateType::Array, comparison: Comparison::Some, value: json!(2)),
+    ];
+    let values = vec![
+      json!(42),
+      json!(41.9999),
+      json!(7),
+      json!("hello world"),
+      json!("HELLO WORLD"),
+      json!(""),
+      json!([1, 2, 3]),
+      json!([]),
+      json!({"a": 1}),
+      json!(true),
+      json!(null),
+    ];
+
+    for predicate in &predicates {
+      let compiled = CompiledPredicate::compile(predicate);
+      for value in &values {
+        let interpreted = validate_predicate(value, predicate).map_err(|e| e.to_string());
+        let evaluated = compiled.evaluate(value).map_err(|e| e.to_string());
+        assert_eq!(
+          evaluated, interpreted,
+          "compiled plan diverged for predicate {:?} on value {}",
+          predicate, value
+        );
+      }
+    }
+  }
 }
@@ -10,7 +10,7 @@ use crate::parser::{
 };
 
 pub fn create_json_config(extractors: Vec<Extractor>) -> ExtractorConfig {
-  ExtractorConfig { format: DataFormat::Json, extractors }
+  ExtractorConfig { format: DataFormat::Json, extractors, early_exit: false }
 }
 
 #[macro_export]
@@ -26,6 +26,7 @@ macro_rules! extractor {
             required: true,
             predicates: Vec::new(),
             attribute: None,
+            compiled_predicates: Default::default(),
         };
 
         // Override default fields with provided arguments
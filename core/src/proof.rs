@@ -2,7 +2,16 @@ use std::convert::TryFrom;
 
 use serde::{Deserialize, Serialize};
 
-#[derive(Serialize, Deserialize, Clone, Debug)]
+use crate::error::WebProverCoreError;
+
+/// Version tag prefixed to the compact binary proof encoding, so the layout
+/// can evolve without breaking stored proofs.
+const COMPACT_PROOF_VERSION: u8 = 1;
+/// Compact encoding version for aggregated proofs, which carry a Merkle
+/// inclusion path and leaf index after the version-1 fields.
+const COMPACT_PROOF_VERSION_AGGREGATED: u8 = 2;
+
+#[derive(Serialize, Deserialize, Clone, Debug, PartialEq)]
 pub struct SignedVerificationReply {
   pub merkle_leaves: Vec<String>,
   pub digest:        String,
@@ -11,9 +20,17 @@ pub struct SignedVerificationReply {
   pub signature_s:   String,
   pub signature_v:   u8,
   pub signer:        String,
+  /// Inclusion path from this proof's leaf to the aggregate Merkle root, set
+  /// only when the notary amortizes one signature across a batch of proofs.
+  /// In that mode `digest` is the aggregate root and the signature covers it.
+  #[serde(default, skip_serializing_if = "Option::is_none")]
+  pub merkle_path:   Option<Vec<String>>,
+  /// Index of this proof's leaf within the aggregate tree.
+  #[serde(default, skip_serializing_if = "Option::is_none")]
+  pub leaf_index:    Option<u32>,
 }
 
-#[derive(Debug, Deserialize, Serialize, Clone)]
+#[derive(Debug, Deserialize, Serialize, Clone, PartialEq)]
 pub struct TeeProof {
   pub data:      TeeProofData,
   pub signature: SignedVerificationReply,
@@ -31,7 +48,276 @@ impl TryFrom<TeeProof> for Vec<u8> {
   fn try_from(proof: TeeProof) -> Result<Self, Self::Error> { serde_json::to_vec(&proof) }
 }
 
-#[derive(Debug, Deserialize, Serialize, Clone)]
+#[derive(Debug, Deserialize, Serialize, Clone, PartialEq)]
 pub struct TeeProofData {
   pub manifest_hash: Vec<u8>,
 }
+
+impl TeeProof {
+  /// Serializes the proof into the compact binary wire format.
+  ///
+  /// The JSON encoding renders every hash as a `"0x..."` hex string, roughly
+  /// tripling the size of the underlying bytes once JSON framing is added.
+  /// The compact form stores fixed-width fields as raw bytes and
+  /// variable-width fields behind length prefixes (big-endian):
+  ///
+  /// ```text
+  /// u8  version
+  /// u16 manifest_hash length, then that many bytes
+  /// u8  merkle leaf count, then count * 32-byte leaves
+  /// 32  digest
+  /// u16 DER signature length, then that many bytes
+  /// 32  signature_r
+  /// 32  signature_s
+  /// u8  signature_v
+  /// 20  signer address
+  /// ```
+  ///
+  /// Aggregated proofs are tagged with version 2 and append:
+  ///
+  /// ```text
+  /// u32 leaf index
+  /// u8  path node count, then count * 32-byte path nodes
+  /// ```
+  pub fn to_compact_bytes(&self) -> Result<Vec<u8>, WebProverCoreError> {
+    let reply = &self.signature;
+    let mut out = Vec::with_capacity(256);
+    out.push(if reply.merkle_path.is_some() {
+      COMPACT_PROOF_VERSION_AGGREGATED
+    } else {
+      COMPACT_PROOF_VERSION
+    });
+
+    write_len_prefixed(&mut out, "manifest_hash", &self.data.manifest_hash)?;
+
+    let leaf_count = u8::try_from(reply.merkle_leaves.len())
+      .map_err(|_| encoding_error("merkle_leaves", "more than 255 leaves"))?;
+    out.push(leaf_count);
+    for leaf in &reply.merkle_leaves {
+      out.extend_from_slice(&decode_hex_field("merkle_leaves", leaf, Some(32))?);
+    }
+
+    out.extend_from_slice(&decode_hex_field("digest", &reply.digest, Some(32))?);
+    write_len_prefixed(
+      &mut out,
+      "signature",
+      &decode_hex_field("signature", &reply.signature, None)?,
+    )?;
+    out.extend_from_slice(&decode_hex_field("signature_r", &reply.signature_r, Some(32))?);
+    out.extend_from_slice(&decode_hex_field("signature_s", &reply.signature_s, Some(32))?);
+    out.push(reply.signature_v);
+    out.extend_from_slice(&decode_hex_field("signer", &reply.signer, Some(20))?);
+
+    if let Some(path) = &reply.merkle_path {
+      out.extend_from_slice(&reply.leaf_index.unwrap_or(0).to_be_bytes());
+      let node_count = u8::try_from(path.len())
+        .map_err(|_| encoding_error("merkle_path", "more than 255 nodes"))?;
+      out.push(node_count);
+      for node in path {
+        out.extend_from_slice(&decode_hex_field("merkle_path", node, Some(32))?);
+      }
+    }
+
+    Ok(out)
+  }
+
+  /// Deserializes a proof from the compact binary wire format produced by
+  /// [`TeeProof::to_compact_bytes`].
+  pub fn from_compact_bytes(bytes: &[u8]) -> Result<Self, WebProverCoreError> {
+    let mut reader = Reader { bytes };
+
+    let version = reader.take_u8("version")?;
+    if version != COMPACT_PROOF_VERSION && version != COMPACT_PROOF_VERSION_AGGREGATED {
+      return Err(encoding_error("version", &format!("unsupported version {}", version)));
+    }
+
+    let manifest_hash = reader.take_len_prefixed("manifest_hash")?.to_vec();
+
+    let leaf_count = reader.take_u8("merkle_leaves")?;
+    let mut merkle_leaves = Vec::with_capacity(leaf_count as usize);
+    for _ in 0..leaf_count {
+      merkle_leaves.push(encode_hex_field(reader.take("merkle_leaves", 32)?));
+    }
+
+    let digest = encode_hex_field(reader.take("digest", 32)?);
+    let signature = encode_hex_field(reader.take_len_prefixed("signature")?);
+    let signature_r = encode_hex_field(reader.take("signature_r", 32)?);
+    let signature_s = encode_hex_field(reader.take("signature_s", 32)?);
+    let signature_v = reader.take_u8("signature_v")?;
+    let signer = encode_hex_field(reader.take("signer", 20)?);
+
+    let (merkle_path, leaf_index) = if version == COMPACT_PROOF_VERSION_AGGREGATED {
+      let index_bytes = reader.take("leaf_index", 4)?;
+      let leaf_index =
+        u32::from_be_bytes([index_bytes[0], index_bytes[1], index_bytes[2], index_bytes[3]]);
+      let node_count = reader.take_u8("merkle_path")?;
+      let mut path = Vec::with_capacity(node_count as usize);
+      for _ in 0..node_count {
+        path.push(encode_hex_field(reader.take("merkle_path", 32)?));
+      }
+      (Some(path), Some(leaf_index))
+    } else {
+      (None, None)
+    };
+
+    if !reader.bytes.is_empty() {
+      return Err(encoding_error("proof", "trailing bytes after proof"));
+    }
+
+    Ok(TeeProof {
+      data:      TeeProofData { manifest_hash },
+      signature: SignedVerificationReply {
+        merkle_leaves,
+        digest,
+        signature,
+        signature_r,
+        signature_s,
+        signature_v,
+        signer,
+        merkle_path,
+        leaf_index,
+      },
+    })
+  }
+}
+
+fn encoding_error(field: &str, reason: &str) -> WebProverCoreError {
+  WebProverCoreError::ProofEncoding(format!("{}: {}", field, reason))
+}
+
+/// Decodes a `"0x..."` hex field, enforcing `expected_len` bytes when given
+fn decode_hex_field(
+  field: &str,
+  value: &str,
+  expected_len: Option<usize>,
+) -> Result<Vec<u8>, WebProverCoreError> {
+  let stripped =
+    value.strip_prefix("0x").ok_or_else(|| encoding_error(field, "missing 0x prefix"))?;
+  let bytes =
+    hex::decode(stripped).map_err(|e| encoding_error(field, &format!("invalid hex: {}", e)))?;
+  if let Some(expected) = expected_len {
+    if bytes.len() != expected {
+      return Err(encoding_error(
+        field,
+        &format!("expected {} bytes, got {}", expected, bytes.len()),
+      ));
+    }
+  }
+  Ok(bytes)
+}
+
+fn encode_hex_field(bytes: &[u8]) -> String { format!("0x{}", hex::encode(bytes)) }
+
+fn write_len_prefixed(
+  out: &mut Vec<u8>,
+  field: &str,
+  bytes: &[u8],
+) -> Result<(), WebProverCoreError> {
+  let len =
+    u16::try_from(bytes.len()).map_err(|_| encoding_error(field, "longer than 65535 bytes"))?;
+  out.extend_from_slice(&len.to_be_bytes());
+  out.extend_from_slice(bytes);
+  Ok(())
+}
+
+struct Reader<'a> {
+  bytes: &'a [u8],
+}
+
+impl<'a> Reader<'a> {
+  fn take(&mut self, field: &str, n: usize) -> Result<&'a [u8], WebProverCoreError> {
+    if self.bytes.len() < n {
+      return Err(encoding_error(field, "unexpected end of input"));
+    }
+    let (taken, rest) = self.bytes.split_at(n);
+    self.bytes = rest;
+    Ok(taken)
+  }
+
+  fn take_u8(&mut self, field: &str) -> Result<u8, WebProverCoreError> {
+    Ok(self.take(field, 1)?[0])
+  }
+
+  fn take_len_prefixed(&mut self, field: &str) -> Result<&'a [u8], WebProverCoreError> {
+    let len_bytes = self.take(field, 2)?;
+    let len = u16::from_be_bytes([len_bytes[0], len_bytes[1]]) as usize;
+    self.take(field, len)
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn sample_proof() -> TeeProof {
+    TeeProof {
+      data:      TeeProofData { manifest_hash: vec![0xab; 32] },
+      signature: SignedVerificationReply {
+        merkle_leaves: vec![encode_hex_field(&[0x11; 32]), encode_hex_field(&[0x22; 32])],
+        digest:        encode_hex_field(&[0x33; 32]),
+        signature:     encode_hex_field(&[0x44; 70]),
+        signature_r:   encode_hex_field(&[0x55; 32]),
+        signature_s:   encode_hex_field(&[0x66; 32]),
+        signature_v:   28,
+        signer:        encode_hex_field(&[0x77; 20]),
+        merkle_path:   None,
+        leaf_index:    None,
+      },
+    }
+  }
+
+  #[test]
+  fn test_compact_round_trip() {
+    let proof = sample_proof();
+    let bytes = proof.to_compact_bytes().unwrap();
+    let decoded = TeeProof::from_compact_bytes(&bytes).unwrap();
+    assert_eq!(proof, decoded);
+  }
+
+  #[test]
+  fn test_compact_round_trip_aggregated() {
+    let mut proof = sample_proof();
+    proof.signature.merkle_path =
+      Some(vec![encode_hex_field(&[0x88; 32]), encode_hex_field(&[0x99; 32])]);
+    proof.signature.leaf_index = Some(5);
+
+    let bytes = proof.to_compact_bytes().unwrap();
+    assert_eq!(bytes[0], COMPACT_PROOF_VERSION_AGGREGATED);
+    let decoded = TeeProof::from_compact_bytes(&bytes).unwrap();
+    assert_eq!(proof, decoded);
+  }
+
+  #[test]
+  fn test_compact_is_smaller_than_json() {
+    let proof = sample_proof();
+    let compact = proof.to_compact_bytes().unwrap();
+    let json: Vec<u8> = proof.try_into().unwrap();
+    assert!(compact.len() * 2 < json.len(), "{} vs {}", compact.len(), json.len());
+  }
+
+  #[test]
+  fn test_compact_rejects_malformed_input() {
+    let proof = sample_proof();
+    let mut bytes = proof.to_compact_bytes().unwrap();
+
+    // Unsupported version
+    let mut wrong_version = bytes.clone();
+    wrong_version[0] = 0xff;
+    assert!(TeeProof::from_compact_bytes(&wrong_version).is_err());
+
+    // Truncated input
+    bytes.truncate(bytes.len() - 1);
+    assert!(TeeProof::from_compact_bytes(&bytes).is_err());
+  }
+
+  #[test]
+  fn test_compact_rejects_bad_hex_fields() {
+    let mut proof = sample_proof();
+    proof.signature.digest = "not-hex".to_string();
+    assert!(proof.to_compact_bytes().is_err());
+
+    let mut proof = sample_proof();
+    proof.signature.signer = encode_hex_field(&[0x77; 21]);
+    assert!(proof.to_compact_bytes().is_err());
+  }
+}
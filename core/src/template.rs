@@ -4,6 +4,8 @@
 //! Template variables are used to parameterize manifest fields and are identified
 //! by the pattern `<% variable_name %>`.
 
+use std::{collections::HashMap, sync::OnceLock};
+
 use derive_more::Display;
 use serde::{Deserialize, Serialize};
 
@@ -15,6 +17,12 @@ use crate::error::TemplateError;
 /// consists of word characters.
 const TEMPLATE_VAR_PATTERN: &str = r"<%\s*(\w+)\s*%>";
 
+/// Returns the compiled template-variable regex, built on first use
+fn token_regex() -> &'static regex::Regex {
+  static TOKEN_REGEX: OnceLock<regex::Regex> = OnceLock::new();
+  TOKEN_REGEX.get_or_init(|| regex::Regex::new(TEMPLATE_VAR_PATTERN).unwrap())
+}
+
 /// Default value for the required field is true
 const DEFAULT_REQUIRED: bool = true;
 fn default_required() -> bool { DEFAULT_REQUIRED }
@@ -78,10 +86,85 @@ impl TemplateVar {
   }
 }
 
+/// The request field a template token was found in
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum TokenField {
+  /// A request header value, identified by header name
+  Header(String),
+  /// A location inside the request body, as a JSON pointer
+  Body(String),
+}
+
+/// A single occurrence of a template token
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct TokenLocation {
+  /// The field whose string value contains the token
+  pub field: TokenField,
+  /// Byte range of the whole `<% name %>` marker within that string
+  pub span:  (usize, usize),
+}
+
+/// An index of every template token in a request: which fields contain which
+/// tokens, with the marker spans inside each field.
+///
+/// Token positions are a static property of the manifest, so the index is
+/// built once (at manifest compilation) and then queried per request instead
+/// of re-scanning the whole document with the regex.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct TokenIndex {
+  locations: HashMap<String, Vec<TokenLocation>>,
+}
+
+impl TokenIndex {
+  /// Records every token occurrence in `text`, attributed to `field`
+  pub fn index_string(&mut self, field: &TokenField, text: &str) {
+    for capture in token_regex().captures_iter(text) {
+      let marker = capture.get(0).unwrap();
+      let name = capture.get(1).unwrap().as_str();
+      self
+        .locations
+        .entry(name.to_string())
+        .or_default()
+        .push(TokenLocation { field: field.clone(), span: (marker.start(), marker.end()) });
+    }
+  }
+
+  /// Recursively records every token occurrence in a JSON value; `pointer` is
+  /// the JSON-pointer prefix of `value` within the body (`""` for the root)
+  pub fn index_value(&mut self, pointer: &str, value: &serde_json::Value) {
+    match value {
+      serde_json::Value::String(s) => self.index_string(&TokenField::Body(pointer.to_string()), s),
+      serde_json::Value::Object(map) =>
+        for (key, v) in map {
+          self.index_value(&format!("{}/{}", pointer, key), v);
+        },
+      serde_json::Value::Array(arr) =>
+        for (i, v) in arr.iter().enumerate() {
+          self.index_value(&format!("{}/{}", pointer, i), v);
+        },
+      _ => {},
+    }
+  }
+
+  /// Returns `true` if the token appears anywhere in the indexed request
+  pub fn contains(&self, name: &str) -> bool { self.locations.contains_key(name) }
+
+  /// Iterates over the distinct token names in the index
+  pub fn tokens(&self) -> impl Iterator<Item = &str> { self.locations.keys().map(String::as_str) }
+
+  /// Returns every occurrence of the given token
+  pub fn locations(&self, name: &str) -> &[TokenLocation] {
+    self.locations.get(name).map(Vec::as_slice).unwrap_or(&[])
+  }
+
+  /// Returns `true` if no tokens were found
+  pub fn is_empty(&self) -> bool { self.locations.is_empty() }
+}
+
 /// Extracts template variable tokens from a JSON value.
 pub fn extract_tokens(value: &serde_json::Value) -> Vec<String> {
   let mut tokens = Vec::new();
-  let token_regex = regex::Regex::new(TEMPLATE_VAR_PATTERN).unwrap();
+  let token_regex = token_regex();
 
   match value {
     serde_json::Value::String(s) =>
@@ -300,6 +383,29 @@ mod tests {
     assert!(tokens.contains(&"token".to_string()));
   }
 
+  #[test]
+  fn test_token_index_fields_and_spans() {
+    let mut index = TokenIndex::default();
+    index.index_string(&TokenField::Header("Authorization".to_string()), "Bearer <% token %>");
+    index.index_value("", &json!({"user": {"name": "<% name %>"}, "items": ["<% token %>"]}));
+
+    assert!(index.contains("token"));
+    assert!(index.contains("name"));
+    assert!(!index.contains("missing"));
+    assert_eq!(index.tokens().count(), 2);
+
+    let token_locations = index.locations("token");
+    assert_eq!(token_locations.len(), 2);
+    assert_eq!(token_locations[0].field, TokenField::Header("Authorization".to_string()));
+    assert_eq!(token_locations[0].span, (7, 18));
+    assert_eq!(token_locations[1].field, TokenField::Body("/items/0".to_string()));
+
+    assert_eq!(index.locations("name"), &[TokenLocation {
+      field: TokenField::Body("/user/name".to_string()),
+      span:  (0, 10),
+    }]);
+  }
+
   #[test]
   fn test_template_var_defaults() {
     let var = TemplateVar::new(None, DEFAULT_REQUIRED, None, None);
@@ -0,0 +1,186 @@
+use std::{
+  collections::HashMap,
+  sync::{Arc, RwLock},
+  time::Duration,
+};
+
+use serde::Deserialize;
+use tokio::sync::{OwnedSemaphorePermit, Semaphore};
+use tracing::debug;
+
+use crate::error::NotaryServerError;
+
+/// Safety valve against unbounded growth of the per-origin semaphore map;
+/// the working set of target origins is small, so blowing past this means
+/// garbage input and dropping the map is the cheapest recovery.
+const MAX_TRACKED_ORIGINS: usize = 1024;
+
+/// Fraction of the global budget the batch lane may occupy, as a divisor.
+/// Batch traffic can fill at most half the slots, so interactive
+/// notarizations always find headroom.
+const BATCH_LANE_DIVISOR: usize = 2;
+
+/// Scheduling lane for a notarization, chosen by the client via the
+/// `priority` query parameter. Interactive requests draw straight from the
+/// global budget; batch requests are additionally capped to a fraction of it.
+#[derive(Clone, Copy, Debug, Default, Deserialize, PartialEq)]
+#[serde(rename_all = "lowercase")]
+pub enum Priority {
+  #[default]
+  Interactive,
+  Batch,
+}
+
+/// Bounded admission for the proof pipeline.
+///
+/// Every admitted notarization holds an upstream fetch and a buffered
+/// response body, so concurrency is capped globally and partitioned per
+/// target origin — one slow origin queues against its own share instead of
+/// occupying every slot. Requests that cannot get a slot within the queue
+/// deadline are shed with a 503 and a Retry-After rather than being left to
+/// time out against the upstream.
+pub struct AdmissionControl {
+  global:           Arc<Semaphore>,
+  batch_lane:       Arc<Semaphore>,
+  per_origin:       RwLock<HashMap<String, Arc<Semaphore>>>,
+  per_origin_limit: usize,
+  queue_deadline:   Duration,
+}
+
+/// Slots held for one admitted notarization; dropping it releases them.
+pub struct AdmissionPermit {
+  _origin: OwnedSemaphorePermit,
+  _global: OwnedSemaphorePermit,
+  _batch:  Option<OwnedSemaphorePermit>,
+}
+
+impl AdmissionControl {
+  pub fn new(max_concurrent: usize, per_origin_limit: usize, queue_deadline: Duration) -> Self {
+    let max_concurrent = max_concurrent.max(1);
+    Self {
+      global: Arc::new(Semaphore::new(max_concurrent)),
+      batch_lane: Arc::new(Semaphore::new((max_concurrent / BATCH_LANE_DIVISOR).max(1))),
+      per_origin: RwLock::new(HashMap::new()),
+      per_origin_limit: per_origin_limit.max(1).min(max_concurrent),
+      queue_deadline,
+    }
+  }
+
+  /// Waits for a slot for one notarization against `origin`, shedding with
+  /// [`NotaryServerError::Overloaded`] once the queue deadline passes. The
+  /// global permit is acquired last: batch and per-origin caps are taken
+  /// first so a request queued on its own lane or on a saturated origin
+  /// cannot camp on a global slot and starve other origins.
+  pub async fn admit(
+    &self,
+    origin: &str,
+    priority: Priority,
+  ) -> Result<AdmissionPermit, NotaryServerError> {
+    let origin_semaphore = self.origin_semaphore(origin);
+    let acquire = async {
+      let batch = match priority {
+        // Acquiring on a semaphore we hold open cannot fail
+        Priority::Batch => Some(self.batch_lane.clone().acquire_owned().await.unwrap()),
+        Priority::Interactive => None,
+      };
+      let origin = origin_semaphore.acquire_owned().await.unwrap();
+      let global = self.global.clone().acquire_owned().await.unwrap();
+      AdmissionPermit { _origin: origin, _global: global, _batch: batch }
+    };
+
+    match tokio::time::timeout(self.queue_deadline, acquire).await {
+      Ok(permit) => Ok(permit),
+      Err(_) => {
+        debug!("Shedding {:?} request for origin {}", priority, origin);
+        Err(NotaryServerError::Overloaded {
+          retry_after_seconds: self.queue_deadline.as_secs().max(1),
+        })
+      },
+    }
+  }
+
+  fn origin_semaphore(&self, origin: &str) -> Arc<Semaphore> {
+    if let Some(semaphore) = self.per_origin.read().unwrap().get(origin) {
+      return semaphore.clone();
+    }
+    let mut origins = self.per_origin.write().unwrap();
+    if origins.len() >= MAX_TRACKED_ORIGINS {
+      origins.clear();
+    }
+    origins
+      .entry(origin.to_string())
+      .or_insert_with(|| Arc::new(Semaphore::new(self.per_origin_limit)))
+      .clone()
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[tokio::test]
+  async fn test_per_origin_budget_does_not_starve_other_origins() {
+    let admission = AdmissionControl::new(8, 1, Duration::from_millis(50));
+
+    // First request against a.example holds that origin's only slot
+    let held = admission.admit("a.example", Priority::Interactive).await.unwrap();
+
+    // A second request for the same origin is shed at the deadline...
+    let err = admission.admit("a.example", Priority::Interactive).await;
+    assert!(matches!(err, Err(NotaryServerError::Overloaded { .. })));
+
+    // ...while another origin is admitted immediately
+    let other = admission.admit("b.example", Priority::Interactive).await;
+    assert!(other.is_ok());
+
+    // Releasing the held slot lets a.example through again
+    drop(held);
+    assert!(admission.admit("a.example", Priority::Interactive).await.is_ok());
+  }
+
+  #[tokio::test]
+  async fn test_queued_origin_waiters_do_not_hold_global_slots() {
+    // Global budget of 2, one slot per origin
+    let admission = Arc::new(AdmissionControl::new(2, 1, Duration::from_millis(250)));
+
+    // a.example's only slot is held, so every further a.example request queues
+    let held = admission.admit("a.example", Priority::Interactive).await.unwrap();
+
+    // Queue more a.example waiters than the whole global budget; if waiting on
+    // the origin cap held a global permit, these alone would exhaust it
+    let waiters: Vec<_> = (0..4)
+      .map(|_| {
+        let admission = admission.clone();
+        tokio::spawn(async move { admission.admit("a.example", Priority::Interactive).await })
+      })
+      .collect();
+    tokio::time::sleep(Duration::from_millis(20)).await;
+
+    // Other origins still admit immediately while those waiters are queued
+    let other = admission.admit("b.example", Priority::Interactive).await;
+    assert!(other.is_ok());
+
+    drop(held);
+    // One waiter inherits a.example's freed slot; the rest are shed
+    let outcomes: Vec<_> =
+      futures::future::join_all(waiters).await.into_iter().map(|r| r.unwrap()).collect();
+    assert_eq!(outcomes.iter().filter(|outcome| outcome.is_ok()).count(), 1);
+    assert!(outcomes
+      .iter()
+      .all(|outcome| matches!(outcome, Ok(_) | Err(NotaryServerError::Overloaded { .. }))));
+  }
+
+  #[tokio::test]
+  async fn test_batch_lane_leaves_headroom_for_interactive() {
+    // Global budget of 4 leaves the batch lane capped at 2
+    let admission = AdmissionControl::new(4, 4, Duration::from_millis(50));
+
+    let _batch_1 = admission.admit("a.example", Priority::Batch).await.unwrap();
+    let _batch_2 = admission.admit("b.example", Priority::Batch).await.unwrap();
+    let shed = admission.admit("c.example", Priority::Batch).await;
+    assert!(matches!(shed, Err(NotaryServerError::Overloaded { .. })));
+
+    // Interactive traffic still fits in the remaining global slots
+    assert!(admission.admit("d.example", Priority::Interactive).await.is_ok());
+  }
+}
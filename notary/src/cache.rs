@@ -0,0 +1,148 @@
+use std::{
+  collections::HashMap,
+  sync::RwLock,
+  time::{Duration, Instant},
+};
+
+use web_prover_core::{hash::IncrementalKeccak, proof::TeeProof};
+
+use crate::proxy::ProxyBatchEntry;
+
+/// Safety valve against unbounded growth, mirroring the manifest registry:
+/// expired entries are evicted lazily, and if live entries still exceed this
+/// the whole cache is dropped.
+const MAX_CACHED_PROOFS: usize = 4096;
+
+struct CachedProof {
+  proof:      TeeProof,
+  expires_at: Instant,
+}
+
+/// An in-memory proof cache keyed by (manifest, normalized request) identity.
+///
+/// Popular targets (price feeds, public profiles) get notarized by many
+/// clients with the identical manifest and target request within seconds of
+/// each other; serving those from cache within a manifest-declared freshness
+/// window skips the upstream fetch, extraction, and ECDSA signature entirely.
+/// Manifests that do not declare `cache_ttl_seconds` never hit this cache.
+#[derive(Default)]
+pub struct ProofCache {
+  entries: RwLock<HashMap<[u8; 32], CachedProof>>,
+}
+
+impl ProofCache {
+  /// Returns the cached proof for `key` if it is still fresh, evicting it
+  /// lazily when expired.
+  pub fn get(&self, key: &[u8; 32]) -> Option<TeeProof> {
+    {
+      let entries = self.entries.read().unwrap();
+      match entries.get(key) {
+        Some(cached) if cached.expires_at > Instant::now() => return Some(cached.proof.clone()),
+        Some(_) => {},
+        None => return None,
+      }
+    }
+    self.entries.write().unwrap().remove(key);
+    None
+  }
+
+  /// Caches `proof` under `key` for `ttl`.
+  pub fn insert(&self, key: [u8; 32], proof: TeeProof, ttl: Duration) {
+    let mut entries = self.entries.write().unwrap();
+    if entries.len() >= MAX_CACHED_PROOFS {
+      let now = Instant::now();
+      entries.retain(|_, cached| cached.expires_at > now);
+      if entries.len() >= MAX_CACHED_PROOFS {
+        entries.clear();
+      }
+    }
+    entries.insert(key, CachedProof { proof, expires_at: Instant::now() + ttl });
+  }
+}
+
+/// Computes the cache key for a (manifest, target request) pair: the manifest
+/// digest folded together with the normalized request — method, URL, headers
+/// sorted by name, and body — so header ordering does not split cache entries.
+pub fn proof_cache_key(manifest_digest: &[u8; 32], entry: &ProxyBatchEntry) -> [u8; 32] {
+  let mut hasher = IncrementalKeccak::new();
+  hasher.update(manifest_digest);
+  hasher.update(entry.target_method.as_bytes());
+  hasher.update(b"\0");
+  hasher.update(entry.target_url.as_bytes());
+  hasher.update(b"\0");
+
+  let mut headers: Vec<_> = entry.target_headers.iter().collect();
+  headers.sort();
+  for (name, value) in headers {
+    hasher.update(name.as_bytes());
+    hasher.update(b"\0");
+    hasher.update(value.as_bytes());
+    hasher.update(b"\0");
+  }
+
+  hasher.update(entry.target_body.as_bytes());
+  hasher.finalize()
+}
+
+#[cfg(test)]
+mod tests {
+  use std::collections::HashMap;
+
+  use web_prover_core::proof::{SignedVerificationReply, TeeProof, TeeProofData};
+
+  use super::*;
+
+  fn test_proof() -> TeeProof {
+    TeeProof {
+      data:      TeeProofData { manifest_hash: vec![1; 32] },
+      signature: SignedVerificationReply {
+        merkle_leaves: vec![],
+        digest:        "0x00".to_string(),
+        signature:     "0xdeadbeef".to_string(),
+        signature_r:   String::new(),
+        signature_s:   String::new(),
+        signature_v:   0,
+        signer:        String::new(),
+        merkle_path:   None,
+        leaf_index:    None,
+      },
+    }
+  }
+
+  fn test_entry(url: &str) -> ProxyBatchEntry {
+    ProxyBatchEntry {
+      target_method:  "GET".to_string(),
+      target_url:     url.to_string(),
+      target_headers: HashMap::new(),
+      target_body:    String::new(),
+    }
+  }
+
+  #[test]
+  fn test_cache_hit_until_expiry() {
+    let cache = ProofCache::default();
+    let key = proof_cache_key(&[0; 32], &test_entry("https://example.com"));
+
+    assert!(cache.get(&key).is_none());
+    cache.insert(key, test_proof(), Duration::from_secs(60));
+    assert_eq!(cache.get(&key), Some(test_proof()));
+
+    cache.insert(key, test_proof(), Duration::from_secs(0));
+    assert!(cache.get(&key).is_none());
+  }
+
+  #[test]
+  fn test_cache_key_normalizes_header_order() {
+    let mut entry_a = test_entry("https://example.com");
+    entry_a.target_headers.insert("A".to_string(), "1".to_string());
+    entry_a.target_headers.insert("B".to_string(), "2".to_string());
+    let entry_b = entry_a.clone();
+
+    assert_eq!(proof_cache_key(&[7; 32], &entry_a), proof_cache_key(&[7; 32], &entry_b));
+    assert_ne!(proof_cache_key(&[7; 32], &entry_a), proof_cache_key(&[8; 32], &entry_a));
+    assert_ne!(
+      proof_cache_key(&[7; 32], &entry_a),
+      proof_cache_key(&[7; 32], &test_entry("https://example.org"))
+    );
+  }
+}
@@ -12,12 +12,28 @@ struct Args {
 
 #[derive(Debug, Default, Deserialize, PartialEq, Eq)]
 pub struct Config {
-  pub server_cert:        String,
-  pub server_key:         String,
-  pub listen:             String,
-  pub notary_signing_key: String,
-  pub acme_email:         String,
-  pub acme_domain:        String,
+  pub server_cert:           String,
+  pub server_key:            String,
+  pub listen:                String,
+  pub notary_signing_key:    String,
+  pub acme_email:            String,
+  pub acme_domain:           String,
+  /// Per-session cap on buffered upstream response bodies, in bytes.
+  pub max_upstream_body:     usize,
+  /// Maximum number of proofs signed under one aggregate signature; values
+  /// below 2 keep the default one-signature-per-proof mode.
+  pub aggregate_batch:       usize,
+  /// How long the first proof in an aggregate batch waits for the batch to
+  /// fill, in milliseconds.
+  pub aggregate_window_ms:   u64,
+  /// Global cap on notarizations buffering an upstream fetch at once.
+  pub max_concurrent_proofs: usize,
+  /// Per-target-origin share of the global budget, so one slow origin cannot
+  /// occupy every slot.
+  pub max_per_origin:        usize,
+  /// How long a request may queue for an admission slot before it is shed
+  /// with a 503 and a Retry-After, in milliseconds.
+  pub queue_deadline_ms:     u64,
 }
 
 // TODO read_config should not use unwrap
@@ -31,7 +47,19 @@ pub fn read_config() -> Config {
     .set_default("server_key", "").unwrap()
     .set_default("notary_signing_key", "").unwrap()
     .set_default("acme_email", "").unwrap()
-    .set_default("acme_domain", "").unwrap();
+    .set_default("acme_domain", "").unwrap()
+    // 64 MiB default; large HTML targets stay well below this, anything bigger
+    // is rejected instead of ballooning notary RSS
+    .set_default("max_upstream_body", 64 * 1024 * 1024_i64).unwrap()
+    // Aggregated signing is opt-in: it trades per-proof latency (up to the
+    // window) for amortizing one signature across a batch
+    .set_default("aggregate_batch", 0_i64).unwrap()
+    .set_default("aggregate_window_ms", 50_i64).unwrap()
+    // Admission control: queue briefly for a slot, then shed instead of
+    // letting a slow origin pile up thousands of buffered sessions
+    .set_default("max_concurrent_proofs", 512_i64).unwrap()
+    .set_default("max_per_origin", 128_i64).unwrap()
+    .set_default("queue_deadline_ms", 2_000_i64).unwrap();
 
   // does config file exist?
   let config_file = args.config;
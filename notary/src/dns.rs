@@ -0,0 +1,172 @@
+use std::{
+  collections::HashMap,
+  net::SocketAddr,
+  sync::{Arc, RwLock},
+  time::{Duration, Instant},
+};
+
+use reqwest::dns::{Addrs, Name, Resolve, Resolving};
+use tracing::debug;
+
+/// How long successful lookups are served from cache. The system resolver
+/// interface (`tokio::net::lookup_host`) does not surface record TTLs, so a
+/// fixed window bounds staleness instead; upstream hosts we notarize against
+/// sit behind load balancers with stable addresses at this horizon.
+const DNS_TTL: Duration = Duration::from_secs(60);
+/// How long failed lookups are cached, so a misconfigured target cannot make
+/// every retry pay a fresh resolver round trip.
+const DNS_NEGATIVE_TTL: Duration = Duration::from_secs(5);
+/// When a cached entry is this close to expiry, a hit serves the cached
+/// addresses and refreshes in the background, so hot hosts never block on a
+/// resolver round trip.
+const DNS_REFRESH_WINDOW: Duration = Duration::from_secs(10);
+/// Safety valve against unbounded growth, mirroring the manifest registry.
+const MAX_CACHED_HOSTS: usize = 1024;
+
+enum CacheEntry {
+  /// Resolved addresses; reqwest rewrites the port per request.
+  Addrs(Vec<SocketAddr>),
+  /// Negative-cache marker holding the original resolver error message.
+  Failed(String),
+}
+
+struct CachedLookup {
+  entry:      CacheEntry,
+  expires_at: Instant,
+}
+
+/// A process-wide caching DNS resolver for the upstream client.
+///
+/// Notaries fetch the same small set of target hostnames continuously, and in
+/// VPC deployments each resolver round trip costs 5-20 ms. Caching positive
+/// lookups for [`DNS_TTL`] (with background refresh-ahead near expiry) and
+/// failures for [`DNS_NEGATIVE_TTL`] takes name resolution out of the
+/// steady-state latency profile entirely.
+#[derive(Clone, Default)]
+pub struct CachingResolver {
+  cache: Arc<RwLock<HashMap<String, CachedLookup>>>,
+}
+
+impl CachingResolver {
+  /// Resolves `host`, consulting the cache first. A hit inside the refresh
+  /// window returns the cached addresses and refreshes in the background.
+  async fn lookup(&self, host: &str) -> Result<Vec<SocketAddr>, std::io::Error> {
+    let now = Instant::now();
+    {
+      let cache = self.cache.read().unwrap();
+      if let Some(cached) = cache.get(host) {
+        if cached.expires_at > now {
+          if let CacheEntry::Addrs(addrs) = &cached.entry {
+            if cached.expires_at - now < DNS_REFRESH_WINDOW {
+              self.spawn_refresh(host);
+            }
+            return Ok(addrs.clone());
+          }
+          if let CacheEntry::Failed(message) = &cached.entry {
+            return Err(std::io::Error::new(std::io::ErrorKind::Other, message.clone()));
+          }
+        }
+      }
+    }
+    self.resolve_and_cache(host).await
+  }
+
+  /// Warms the cache for `host` without blocking the caller: a no-op when a
+  /// fresh entry exists, otherwise a background lookup. Called for hosts seen
+  /// in compiled-manifest requests so their first fetch finds a warm cache.
+  pub fn prefetch(&self, host: &str) {
+    let now = Instant::now();
+    {
+      let cache = self.cache.read().unwrap();
+      if let Some(cached) = cache.get(host) {
+        if cached.expires_at > now && cached.expires_at - now >= DNS_REFRESH_WINDOW {
+          return;
+        }
+      }
+    }
+    self.spawn_refresh(host);
+  }
+
+  fn spawn_refresh(&self, host: &str) {
+    let resolver = self.clone();
+    let host = host.to_string();
+    tokio::spawn(async move {
+      let _ = resolver.resolve_and_cache(&host).await;
+    });
+  }
+
+  /// Performs the actual resolver round trip and caches the outcome, positive
+  /// or negative.
+  async fn resolve_and_cache(&self, host: &str) -> Result<Vec<SocketAddr>, std::io::Error> {
+    // The port is a placeholder for the lookup API; reqwest rewrites it
+    let result = tokio::net::lookup_host((host, 0)).await.map(|addrs| addrs.collect::<Vec<_>>());
+    let (entry, ttl) = match &result {
+      Ok(addrs) => (CacheEntry::Addrs(addrs.clone()), DNS_TTL),
+      Err(e) => {
+        debug!("DNS lookup for {} failed: {}", host, e);
+        (CacheEntry::Failed(e.to_string()), DNS_NEGATIVE_TTL)
+      },
+    };
+
+    let mut cache = self.cache.write().unwrap();
+    if cache.len() >= MAX_CACHED_HOSTS {
+      let now = Instant::now();
+      cache.retain(|_, cached| cached.expires_at > now);
+      if cache.len() >= MAX_CACHED_HOSTS {
+        cache.clear();
+      }
+    }
+    cache.insert(host.to_string(), CachedLookup { entry, expires_at: Instant::now() + ttl });
+    result
+  }
+}
+
+impl Resolve for CachingResolver {
+  fn resolve(&self, name: Name) -> Resolving {
+    let resolver = self.clone();
+    Box::pin(async move {
+      let addrs = resolver.lookup(name.as_str()).await?;
+      Ok(Box::new(addrs.into_iter()) as Addrs)
+    })
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[tokio::test]
+  async fn test_lookup_populates_cache() {
+    let resolver = CachingResolver::default();
+
+    let addrs = resolver.lookup("localhost").await.unwrap();
+    assert!(!addrs.is_empty());
+    assert!(matches!(
+      resolver.cache.read().unwrap().get("localhost").unwrap().entry,
+      CacheEntry::Addrs(_)
+    ));
+  }
+
+  #[tokio::test]
+  async fn test_cached_entries_are_served_until_expiry() {
+    let resolver = CachingResolver::default();
+    let planted = vec!["192.0.2.1:0".parse().unwrap()];
+    {
+      let mut cache = resolver.cache.write().unwrap();
+      cache.insert("planted.example".to_string(), CachedLookup {
+        entry:      CacheEntry::Addrs(planted.clone()),
+        expires_at: Instant::now() + DNS_TTL,
+      });
+      cache.insert("broken.example".to_string(), CachedLookup {
+        entry:      CacheEntry::Failed("no such host".to_string()),
+        expires_at: Instant::now() + DNS_NEGATIVE_TTL,
+      });
+    }
+
+    // Neither lookup pays a resolver round trip: the positive entry returns
+    // the planted addresses, the negative entry replays the failure
+    assert_eq!(resolver.lookup("planted.example").await.unwrap(), planted);
+    let err = resolver.lookup("broken.example").await.unwrap_err();
+    assert!(err.to_string().contains("no such host"));
+  }
+}
@@ -1,5 +1,5 @@
 use axum::{
-  http::StatusCode,
+  http::{header, StatusCode},
   response::{IntoResponse, Response},
 };
 use eyre::Report;
@@ -25,6 +25,12 @@ pub enum ProxyError {
 
   #[error(transparent)]
   SerdeJsonError(#[from] serde_json::Error),
+
+  #[error(transparent)]
+  Reqwest(#[from] reqwest::Error),
+
+  #[error("Invalid upstream request: {0}")]
+  InvalidRequest(String),
 }
 
 #[derive(Debug, thiserror::Error)]
@@ -49,12 +55,24 @@ pub enum NotaryServerError {
 
   #[error(transparent)]
   WebProverCoreError(#[from] WebProverCoreError),
+
+  #[error("Notary overloaded; retry after {retry_after_seconds}s")]
+  Overloaded { retry_after_seconds: u64 },
 }
 
 /// Trait implementation to convert this error into an axum http response
 impl IntoResponse for NotaryServerError {
   fn into_response(self) -> Response {
     error!("notary error: {:?}", self);
+    // Shed load is the client's signal to back off, not a server fault
+    if let NotaryServerError::Overloaded { retry_after_seconds } = self {
+      return (
+        StatusCode::SERVICE_UNAVAILABLE,
+        [(header::RETRY_AFTER, retry_after_seconds.to_string())],
+        "Notary overloaded; retry later.",
+      )
+        .into_response();
+    }
     (StatusCode::INTERNAL_SERVER_ERROR, "Something wrong happened.").into_response()
   }
 }
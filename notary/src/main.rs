@@ -2,6 +2,7 @@ use std::{
   fs,
   io::{self},
   sync::Arc,
+  time::Duration,
 };
 
 use axum::{
@@ -12,15 +13,25 @@ use axum::{
   Router,
 };
 use error::NotaryServerError;
-use hyper::{body::Incoming, server::conn::http1};
-use hyper_util::rt::TokioIo;
-use k256::{ecdsa::SigningKey, elliptic_curve::rand_core, pkcs8::DecodePrivateKey};
+use hyper::body::Incoming;
+use hyper_util::{
+  rt::{TokioExecutor, TokioIo},
+  server::conn::auto,
+};
+use k256::{
+  ecdsa::{SigningKey, VerifyingKey},
+  elliptic_curve::rand_core,
+  pkcs8::DecodePrivateKey,
+};
 use rustls::{
   pki_types::{CertificateDer, PrivateKeyDer},
   ServerConfig,
 };
 use rustls_acme::{caches::DirCache, AcmeConfig};
-use tokio::{io::AsyncWriteExt, net::TcpListener};
+use tokio::{
+  io::AsyncWriteExt,
+  net::{TcpListener, TcpSocket},
+};
 use tokio_rustls::{LazyConfigAcceptor, TlsAcceptor};
 use tokio_stream::StreamExt;
 use tower_http::cors::CorsLayer;
@@ -28,13 +39,117 @@ use tower_service::Service;
 use tracing::{error, info};
 use tracing_subscriber::{layer::SubscriberExt, util::SubscriberInitExt};
 
+mod admission;
+mod cache;
 mod config;
+mod dns;
 mod error;
+mod metrics;
 mod proxy;
+mod registry;
 mod verifier;
 
+/// Timeout for upstream fetches made on behalf of clients.
+const UPSTREAM_TIMEOUT: Duration = Duration::from_secs(30);
+/// How long idle upstream connections are kept around for reuse.
+const UPSTREAM_POOL_IDLE_TIMEOUT: Duration = Duration::from_secs(90);
+/// Maximum number of idle connections kept per upstream origin.
+const UPSTREAM_POOL_MAX_IDLE_PER_HOST: usize = 32;
+/// Number of TLS 1.2 session-ID entries kept for resumption.
+const TLS_SESSION_CACHE_SIZE: usize = 10_240;
+/// Kernel accept backlog per listener shard.
+const LISTEN_BACKLOG: u32 = 1024;
+
 struct SharedState {
-  notary_signing_key: SigningKey,
+  notary_signing_key:    SigningKey,
+  /// Verifying key derived from the signing key once at startup; deriving it
+  /// per signature is an EC scalar multiplication we don't want on the
+  /// signing path.
+  notary_verifying_key:  VerifyingKey,
+  /// Ethereum-style address of the notary signer, likewise fixed for the
+  /// lifetime of the process.
+  notary_signer_address: alloy_primitives::Address,
+  /// Long-lived client for upstream fetches. Shared across requests so repeat
+  /// fetches to the same origin reuse pooled connections and resumed TLS
+  /// sessions instead of paying a fresh TCP+TLS handshake per notarization.
+  upstream_client:       reqwest::Client,
+  /// Process-wide caching DNS resolver backing the upstream client, also used
+  /// to prefetch target hosts ahead of their fetch.
+  dns_resolver:          dns::CachingResolver,
+  /// Per-session cap on buffered upstream response bodies, in bytes.
+  max_upstream_body:     usize,
+  /// Digest-keyed cache of compiled manifests, so repeat requests skip
+  /// serialization and static validation entirely.
+  manifest_registry:     registry::ManifestRegistry,
+  /// Proof memoization cache for manifests that declare a freshness window.
+  proof_cache:           cache::ProofCache,
+  /// Batches proofs under one signature when aggregation is enabled in
+  /// config; `None` keeps the one-signature-per-proof path.
+  signature_aggregator:  Option<verifier::SignatureAggregator>,
+  /// Bounded, origin-partitioned admission for the proof pipeline; requests
+  /// that cannot get a slot before the queue deadline are shed with a 503.
+  admission:             admission::AdmissionControl,
+  /// Per-stage pipeline metrics, scraped via `/metrics`.
+  metrics:               metrics::Metrics,
+}
+
+/// Enables TLS session resumption on a server config: a session ticketer with
+/// automatically rotating keys (so reconnecting clients skip the full
+/// handshake) plus an in-memory session-ID cache for TLS 1.2 clients that
+/// don't support tickets.
+///
+/// Keys rotate per process; sharing them across the fleet so any replica can
+/// resume any client needs external key distribution and is left to the
+/// deployment layer.
+fn enable_session_resumption(config: &mut ServerConfig) -> Result<(), NotaryServerError> {
+  config.ticketer = rustls::crypto::ring::Ticketer::new()
+    .map_err(|e| NotaryServerError::ServerConfigError(e.to_string()))?;
+  config.session_storage = rustls::server::ServerSessionMemoryCache::new(TLS_SESSION_CACHE_SIZE);
+  Ok(())
+}
+
+/// Number of listener shards: one accept loop per core, so accept throughput
+/// scales with cores instead of serializing on a single task during client
+/// reconnect storms after a deploy.
+fn listener_shards() -> usize { std::thread::available_parallelism().map(|n| n.get()).unwrap_or(1) }
+
+/// Binds `shards` SO_REUSEPORT sockets to `addr`. The kernel load-balances
+/// incoming connections across the sockets, so each shard can run its own
+/// accept loop with no shared dispatch point.
+async fn bind_reuseport_listeners(
+  addr: &str,
+  shards: usize,
+) -> Result<Vec<TcpListener>, NotaryServerError> {
+  let addr = tokio::net::lookup_host(addr).await?.next().ok_or_else(|| {
+    NotaryServerError::ServerConfigError(format!("cannot resolve listen address {}", addr))
+  })?;
+  let mut listeners = Vec::with_capacity(shards);
+  for _ in 0..shards {
+    let socket = if addr.is_ipv4() { TcpSocket::new_v4()? } else { TcpSocket::new_v6()? };
+    socket.set_reuseport(true)?;
+    socket.bind(addr)?;
+    listeners.push(socket.listen(LISTEN_BACKLOG)?);
+  }
+  Ok(listeners)
+}
+
+/// Builds the shared upstream HTTP client with keep-alive pooling per origin.
+///
+/// HTTP/2 is negotiated via ALPN where the origin offers it, so concurrent
+/// fetches to the same origin multiplex over one connection; HTTP/1.1 origins
+/// fall back to the pooled sockets. Name resolution goes through the shared
+/// caching resolver.
+fn build_upstream_client(resolver: dns::CachingResolver) -> reqwest::Client {
+  reqwest::Client::builder()
+    .dns_resolver(Arc::new(resolver))
+    .timeout(UPSTREAM_TIMEOUT)
+    .pool_idle_timeout(UPSTREAM_POOL_IDLE_TIMEOUT)
+    .pool_max_idle_per_host(UPSTREAM_POOL_MAX_IDLE_PER_HOST)
+    .tcp_keepalive(Duration::from_secs(60))
+    .http2_keep_alive_interval(Duration::from_secs(30))
+    .http2_adaptive_window(true)
+    .build()
+    .unwrap()
 }
 
 /// Main entry point for the notary server application.
@@ -81,23 +196,55 @@ async fn main() -> Result<(), NotaryServerError> {
 
   let c = config::read_config();
 
-  let listener = TcpListener::bind(&c.listen).await?;
+  let listeners = bind_reuseport_listeners(&c.listen, listener_shards()).await?;
   info!("Listening on https://{}", &c.listen);
 
-  let shared_state =
-    Arc::new(SharedState { notary_signing_key: load_notary_signing_key(&c.notary_signing_key) });
+  let notary_signing_key = load_notary_signing_key(&c.notary_signing_key);
+  let notary_verifying_key = *notary_signing_key.verifying_key();
+  let notary_signer_address = alloy_primitives::Address::from_public_key(&notary_verifying_key);
+
+  let signature_aggregator = (c.aggregate_batch > 1).then(|| {
+    verifier::SignatureAggregator::spawn(
+      notary_signing_key.clone(),
+      notary_verifying_key,
+      notary_signer_address,
+      c.aggregate_batch,
+      Duration::from_millis(c.aggregate_window_ms),
+    )
+  });
+
+  let dns_resolver = dns::CachingResolver::default();
+  let shared_state = Arc::new(SharedState {
+    notary_signing_key,
+    notary_verifying_key,
+    notary_signer_address,
+    upstream_client: build_upstream_client(dns_resolver.clone()),
+    dns_resolver,
+    max_upstream_body: c.max_upstream_body,
+    manifest_registry: registry::ManifestRegistry::default(),
+    proof_cache: cache::ProofCache::default(),
+    signature_aggregator,
+    admission: admission::AdmissionControl::new(
+      c.max_concurrent_proofs,
+      c.max_per_origin,
+      Duration::from_millis(c.queue_deadline_ms),
+    ),
+    metrics: metrics::Metrics::default(),
+  });
 
   let router = Router::new()
     .route("/health", get(|| async move { (StatusCode::OK, "Ok").into_response() }))
     .route("/v1/proxy", post(proxy::proxy))
+    .route("/v1/proxy/batch", post(proxy::proxy_batch))
     .route("/v1/meta/keys/:key", get(meta_keys))
+    .route("/metrics", get(serve_metrics))
     .layer(CorsLayer::permissive())
     .with_state(shared_state);
 
   if !c.server_cert.is_empty() || !c.server_key.is_empty() {
-    let _ = listen(listener, router, &c.server_cert, &c.server_key).await;
+    let _ = listen(listeners, router, &c.server_cert, &c.server_key).await;
   } else {
-    let _ = acme_listen(listener, router, &c.acme_domain, &c.acme_email).await;
+    let _ = acme_listen(listeners, router, &c.acme_domain, &c.acme_email).await;
   }
   Ok(())
 }
@@ -112,7 +259,8 @@ async fn main() -> Result<(), NotaryServerError> {
 ///
 /// # Arguments
 ///
-/// * `listener` - TCP listener bound to the server's address
+/// * `listeners` - SO_REUSEPORT listener shards bound to the server's address; each shard runs its
+///   own accept loop so accept throughput scales with cores
 /// * `router` - Axum router containing the HTTP request handlers
 /// * `domain` - Domain name for which to obtain certificates
 /// * `email` - Contact email address for Let's Encrypt registration
@@ -134,13 +282,11 @@ async fn main() -> Result<(), NotaryServerError> {
 /// Connection-level errors and ACME events are logged but do not terminate the server.
 /// Certificate renewal errors are handled automatically with exponential backoff.
 async fn acme_listen(
-  listener: TcpListener,
+  listeners: Vec<TcpListener>,
   router: Router,
   domain: &str,
   email: &str,
 ) -> Result<(), NotaryServerError> {
-  let protocol = Arc::new(http1::Builder::new());
-
   let mut state = AcmeConfig::new([domain])
     .contact_push(format!("mailto:{}", email))
     .cache(DirCache::new("./rustls_acme_cache")) // TODO make this a config
@@ -150,7 +296,9 @@ async fn acme_listen(
 
   let mut rustls_config =
     ServerConfig::builder().with_no_client_auth().with_cert_resolver(state.resolver());
-  rustls_config.alpn_protocols = vec![b"http/1.1".to_vec()];
+  rustls_config.alpn_protocols = vec![b"h2".to_vec(), b"http/1.1".to_vec()];
+  enable_session_resumption(&mut rustls_config)?;
+  let rustls_config = Arc::new(rustls_config);
 
   tokio::spawn(async move {
     loop {
@@ -166,6 +314,33 @@ async fn acme_listen(
     }
   });
 
+  let shards: Vec<_> = listeners
+    .into_iter()
+    .map(|listener| {
+      let challenge_rustls_config = challenge_rustls_config.clone();
+      let rustls_config = rustls_config.clone();
+      let router = router.clone();
+      tokio::spawn(acme_accept_loop(listener, challenge_rustls_config, rustls_config, router))
+    })
+    .collect();
+  for shard in shards {
+    let _ = shard.await;
+  }
+  Ok(())
+}
+
+/// Accept loop for one ACME listener shard: resolves the TLS-ALPN-01
+/// challenge inline and serves regular connections with the shard's own
+/// protocol builder, so handshake dispatch never crosses shards.
+async fn acme_accept_loop(
+  listener: TcpListener,
+  challenge_rustls_config: Arc<ServerConfig>,
+  rustls_config: Arc<ServerConfig>,
+  router: Router,
+) {
+  // Serves HTTP/1.1 or HTTP/2 per connection, as negotiated via ALPN
+  let protocol = Arc::new(auto::Builder::new(TokioExecutor::new()));
+
   loop {
     let (tcp, _) = match listener.accept().await {
       Ok(connection) => connection,
@@ -201,7 +376,7 @@ async fn acme_listen(
           error!("Failed to shutdown TLS-ALPN challenge connection: {}", e);
         }
       } else {
-        let tls = match start_handshake.into_stream(Arc::new(rustls_config)).await {
+        let tls = match start_handshake.into_stream(rustls_config).await {
           Ok(stream) => stream,
           Err(e) => {
             error!("Failed to establish TLS stream: {}", e);
@@ -212,7 +387,7 @@ async fn acme_listen(
         let hyper_service = hyper::service::service_fn(move |request: Request<Incoming>| {
           tower_service.clone().call(request)
         });
-        if let Err(e) = protocol.serve_connection(io, hyper_service).with_upgrades().await {
+        if let Err(e) = protocol.serve_connection_with_upgrades(io, hyper_service).await {
           error!("Connection error: {}", e);
         }
       }
@@ -230,7 +405,8 @@ async fn acme_listen(
 ///
 /// # Arguments
 ///
-/// * `listener` - TCP listener bound to the server's address
+/// * `listeners` - SO_REUSEPORT listener shards bound to the server's address; each shard runs its
+///   own accept loop and TLS acceptor so handshake throughput scales with cores
 /// * `router` - Axum router containing the HTTP request handlers
 /// * `server_cert_path` - Path to the TLS certificate file in PEM format
 /// * `server_key_path` - Path to the private key file in PEM format
@@ -251,13 +427,11 @@ async fn acme_listen(
 ///
 /// Connection-level errors are logged but do not terminate the server.
 async fn listen(
-  listener: TcpListener,
+  listeners: Vec<TcpListener>,
   router: Router,
   server_cert_path: &str,
   server_key_path: &str,
 ) -> Result<(), NotaryServerError> {
-  let protocol = Arc::new(http1::Builder::new());
-
   info!("Using {} and {}", server_cert_path, server_key_path);
   let certs = match load_certs(server_cert_path) {
     Ok(certs) => certs,
@@ -279,7 +453,8 @@ async fn listen(
     match ServerConfig::builder().with_no_client_auth().with_single_cert(certs, key) {
       Ok(config) => {
         let mut config = config;
-        config.alpn_protocols = vec![b"http/1.1".to_vec()];
+        config.alpn_protocols = vec![b"h2".to_vec(), b"http/1.1".to_vec()];
+        enable_session_resumption(&mut config)?;
         config
       },
       Err(e) => {
@@ -288,7 +463,30 @@ async fn listen(
       },
     };
 
-  let tls_acceptor = TlsAcceptor::from(Arc::new(server_config));
+  // The session ticketer and resumption cache live inside the config, so
+  // sharing one config across shards lets a client resume on whichever shard
+  // the kernel hashes its reconnect to.
+  let server_config = Arc::new(server_config);
+
+  let shards: Vec<_> = listeners
+    .into_iter()
+    .map(|listener| {
+      let tls_acceptor = TlsAcceptor::from(server_config.clone());
+      let router = router.clone();
+      tokio::spawn(accept_loop(listener, tls_acceptor, router))
+    })
+    .collect();
+  for shard in shards {
+    let _ = shard.await;
+  }
+  Ok(())
+}
+
+/// Accept loop for one static-cert listener shard, with its own TLS acceptor
+/// and protocol builder.
+async fn accept_loop(listener: TcpListener, tls_acceptor: TlsAcceptor, router: Router) {
+  // Serves HTTP/1.1 or HTTP/2 per connection, as negotiated via ALPN
+  let protocol = Arc::new(auto::Builder::new(TokioExecutor::new()));
 
   loop {
     let (tcp_stream, _) = match listener.accept().await {
@@ -309,7 +507,7 @@ async fn listen(
           let hyper_service = hyper::service::service_fn(move |request: Request<Incoming>| {
             tower_service.clone().call(request)
           });
-          if let Err(e) = protocol.serve_connection(io, hyper_service).with_upgrades().await {
+          if let Err(e) = protocol.serve_connection_with_upgrades(io, hyper_service).await {
             error!("Connection error: {}", e);
           }
         },
@@ -362,3 +560,8 @@ async fn meta_keys(
     _ => (StatusCode::NOT_FOUND, "".to_string()),
   }
 }
+
+/// Prometheus scrape endpoint exposing the per-stage pipeline metrics
+async fn serve_metrics(State(state): State<Arc<SharedState>>) -> impl IntoResponse {
+  ([(axum::http::header::CONTENT_TYPE, "text/plain; version=0.0.4")], state.metrics.render())
+}
@@ -0,0 +1,210 @@
+//! Hand-rolled Prometheus-format metrics for the notarization hot path.
+//!
+//! Kept dependency-free on purpose: everything is atomics, so recording a
+//! sample on the signing path costs a couple of relaxed `fetch_add`s.
+
+use std::{
+  fmt::Write,
+  sync::atomic::{AtomicU64, Ordering},
+  time::Instant,
+};
+
+/// Bucket bounds for latency histograms, in seconds.
+const LATENCY_BOUNDS: &[f64] =
+  &[0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0];
+
+/// Bucket bounds for body-size histograms, in bytes.
+const SIZE_BOUNDS: &[f64] =
+  &[1024.0, 16384.0, 65536.0, 262144.0, 1048576.0, 4194304.0, 16777216.0, 67108864.0];
+
+/// A fixed-bucket histogram safe to record into from any thread.
+pub struct Histogram {
+  bounds:    &'static [f64],
+  /// One slot per bound plus one overflow slot; cumulated only at render time
+  buckets:   Vec<AtomicU64>,
+  count:     AtomicU64,
+  /// Sum is stored in micro-units so it fits an integer atomic
+  sum_micro: AtomicU64,
+}
+
+impl Histogram {
+  fn new(bounds: &'static [f64]) -> Self {
+    Self {
+      bounds,
+      buckets: (0..=bounds.len()).map(|_| AtomicU64::new(0)).collect(),
+      count: AtomicU64::new(0),
+      sum_micro: AtomicU64::new(0),
+    }
+  }
+
+  pub fn observe(&self, value: f64) {
+    let slot = self.bounds.iter().position(|bound| value <= *bound).unwrap_or(self.bounds.len());
+    self.buckets[slot].fetch_add(1, Ordering::Relaxed);
+    self.count.fetch_add(1, Ordering::Relaxed);
+    self.sum_micro.fetch_add((value * 1e6) as u64, Ordering::Relaxed);
+  }
+
+  /// Records the time elapsed since `started`, in seconds
+  pub fn observe_since(&self, started: Instant) { self.observe(started.elapsed().as_secs_f64()); }
+
+  fn render(&self, out: &mut String, name: &str, help: &str) {
+    let _ = writeln!(out, "# HELP {} {}", name, help);
+    let _ = writeln!(out, "# TYPE {} histogram", name);
+    let mut cumulative = 0u64;
+    for (bound, bucket) in self.bounds.iter().zip(&self.buckets) {
+      cumulative += bucket.load(Ordering::Relaxed);
+      let _ = writeln!(out, "{}_bucket{{le=\"{}\"}} {}", name, bound, cumulative);
+    }
+    cumulative += self.buckets[self.bounds.len()].load(Ordering::Relaxed);
+    let _ = writeln!(out, "{}_bucket{{le=\"+Inf\"}} {}", name, cumulative);
+    let _ = writeln!(out, "{}_sum {}", name, self.sum_micro.load(Ordering::Relaxed) as f64 / 1e6);
+    let _ = writeln!(out, "{}_count {}", name, self.count.load(Ordering::Relaxed));
+  }
+}
+
+fn render_counter(out: &mut String, name: &str, help: &str, value: &AtomicU64) {
+  let _ = writeln!(out, "# HELP {} {}", name, help);
+  let _ = writeln!(out, "# TYPE {} counter", name);
+  let _ = writeln!(out, "{} {}", name, value.load(Ordering::Relaxed));
+}
+
+/// Per-stage instrumentation of the notarization pipeline.
+pub struct Metrics {
+  /// Upstream fetch: request sent until response headers arrive (TTFB)
+  pub upstream_fetch_seconds:    Histogram,
+  /// Upstream fetch: reading the response body off the socket
+  pub upstream_body_seconds:     Histogram,
+  /// Size of buffered upstream response bodies
+  pub upstream_body_bytes:       Histogram,
+  /// Manifest validation plus extraction, against a JSON body
+  pub extraction_json_seconds:   Histogram,
+  /// Manifest validation plus extraction, against an HTML body
+  pub extraction_html_seconds:   Histogram,
+  /// Keccak digests over extraction output and proof value
+  pub digest_seconds:            Histogram,
+  /// Merkle tree construction and ECDSA signing
+  pub sign_seconds:              Histogram,
+  /// Proofs successfully created
+  pub proofs_total:              AtomicU64,
+  /// Notarization attempts that returned an error to the client
+  pub proof_errors_total:        AtomicU64,
+  /// Individual manifest validation errors encountered
+  pub validation_failures_total: AtomicU64,
+  /// Proofs served from the memoization cache without an upstream fetch
+  pub proof_cache_hits_total:    AtomicU64,
+}
+
+impl Default for Metrics {
+  fn default() -> Self {
+    Self {
+      upstream_fetch_seconds:    Histogram::new(LATENCY_BOUNDS),
+      upstream_body_seconds:     Histogram::new(LATENCY_BOUNDS),
+      upstream_body_bytes:       Histogram::new(SIZE_BOUNDS),
+      extraction_json_seconds:   Histogram::new(LATENCY_BOUNDS),
+      extraction_html_seconds:   Histogram::new(LATENCY_BOUNDS),
+      digest_seconds:            Histogram::new(LATENCY_BOUNDS),
+      sign_seconds:              Histogram::new(LATENCY_BOUNDS),
+      proofs_total:              AtomicU64::new(0),
+      proof_errors_total:        AtomicU64::new(0),
+      validation_failures_total: AtomicU64::new(0),
+      proof_cache_hits_total:    AtomicU64::new(0),
+    }
+  }
+}
+
+impl Metrics {
+  /// Renders all metrics in the Prometheus text exposition format
+  pub fn render(&self) -> String {
+    let mut out = String::with_capacity(4096);
+    self.upstream_fetch_seconds.render(
+      &mut out,
+      "notary_upstream_fetch_seconds",
+      "Time from upstream request sent to response headers received",
+    );
+    self.upstream_body_seconds.render(
+      &mut out,
+      "notary_upstream_body_seconds",
+      "Time spent reading the upstream response body",
+    );
+    self.upstream_body_bytes.render(
+      &mut out,
+      "notary_upstream_body_bytes",
+      "Size of buffered upstream response bodies",
+    );
+    self.extraction_json_seconds.render(
+      &mut out,
+      "notary_extraction_json_seconds",
+      "Manifest validation and extraction time for JSON bodies",
+    );
+    self.extraction_html_seconds.render(
+      &mut out,
+      "notary_extraction_html_seconds",
+      "Manifest validation and extraction time for HTML bodies",
+    );
+    self.digest_seconds.render(
+      &mut out,
+      "notary_digest_seconds",
+      "Keccak digest time over extraction output and proof value",
+    );
+    self.sign_seconds.render(
+      &mut out,
+      "notary_sign_seconds",
+      "Merkle tree construction and ECDSA signing time",
+    );
+    render_counter(
+      &mut out,
+      "notary_proofs_total",
+      "Proofs successfully created",
+      &self.proofs_total,
+    );
+    render_counter(
+      &mut out,
+      "notary_proof_errors_total",
+      "Notarization attempts that returned an error",
+      &self.proof_errors_total,
+    );
+    render_counter(
+      &mut out,
+      "notary_validation_failures_total",
+      "Individual manifest validation errors encountered",
+      &self.validation_failures_total,
+    );
+    render_counter(
+      &mut out,
+      "notary_proof_cache_hits_total",
+      "Proofs served from the memoization cache",
+      &self.proof_cache_hits_total,
+    );
+    out
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[test]
+  fn test_histogram_buckets_are_cumulative() {
+    let histogram = Histogram::new(LATENCY_BOUNDS);
+    histogram.observe(0.002);
+    histogram.observe(0.002);
+    histogram.observe(0.3);
+    histogram.observe(100.0); // overflow bucket
+
+    let mut out = String::new();
+    histogram.render(&mut out, "test_seconds", "help");
+    assert!(out.contains("test_seconds_bucket{le=\"0.0025\"} 2"));
+    assert!(out.contains("test_seconds_bucket{le=\"0.5\"} 3"));
+    assert!(out.contains("test_seconds_bucket{le=\"+Inf\"} 4"));
+    assert!(out.contains("test_seconds_count 4"));
+  }
+
+  #[test]
+  fn test_render_includes_counters() {
+    let metrics = Metrics::default();
+    metrics.proofs_total.fetch_add(3, Ordering::Relaxed);
+    let out = metrics.render();
+    assert!(out.contains("# TYPE notary_proofs_total counter"));
+    assert!(out.contains("notary_proofs_total 3"));
+  }
+}
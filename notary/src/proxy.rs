@@ -1,24 +1,33 @@
-use std::{sync::Arc, time::Duration};
+use std::{
+  collections::HashMap,
+  sync::{atomic::Ordering, Arc},
+  time::{Duration, Instant},
+};
 
 use axum::{
   extract::{self, Query, State},
+  http::{header, HeaderMap},
+  response::IntoResponse,
   Json,
 };
 use reqwest::{Request, Response};
-use serde::Deserialize;
-use serde_json::Value;
+use serde::{Deserialize, Serialize};
+use serde_json::{value::RawValue, Value};
 use tracing::{debug, info};
 use uuid::Uuid;
 use web_prover_core::{
-  hash::keccak_digest,
+  hash::IncrementalKeccak,
   http::{
     ManifestRequest, ManifestResponse, ManifestResponseBody, NotaryResponse, NotaryResponseBody,
   },
-  manifest::{Manifest, ManifestValidationResult},
+  manifest::{CompiledManifest, ManifestValidationResult},
+  parser::{DataFormat, ExtractorConfig},
   proof::{TeeProof, TeeProofData},
 };
 
 use crate::{
+  admission::Priority,
+  cache,
   error::{NotaryServerError, ProxyError},
   verifier::{sign_verification, VerifyOutput},
   SharedState,
@@ -27,45 +36,265 @@ use crate::{
 #[derive(Deserialize)]
 pub struct NotarizeQuery {
   session_id: Uuid,
+  /// Bypass the proof cache and force a fresh upstream fetch
+  #[serde(default)]
+  skip_cache: bool,
+  /// Scheduling lane for admission control; single proofs default to
+  /// interactive, batches to batch
+  priority:   Option<Priority>,
+}
+
+/// One target request in a `/v1/proxy/batch` payload. Mirrors the `target_*`
+/// fields of `ProxyConfig`; the manifest is shared across the whole batch.
+#[derive(Clone, Deserialize)]
+pub struct ProxyBatchEntry {
+  pub target_method:  String,
+  pub target_url:     String,
+  #[serde(default)]
+  pub target_headers: HashMap<String, String>,
+  #[serde(default)]
+  pub target_body:    String,
+}
+
+/// Wire-compatible view of `web_prover_client::ProxyConfig` that keeps the
+/// manifest as raw JSON. The registry resolves repeated manifests by the
+/// digest of these bytes, so the steady-state request path never
+/// deserializes a manifest (or allocates its strings) at all.
+#[derive(Deserialize)]
+pub struct RawProxyConfig {
+  pub target_method:  String,
+  pub target_url:     String,
+  pub target_headers: HashMap<String, String>,
+  pub target_body:    String,
+  pub manifest:       Box<RawValue>,
+}
+
+#[derive(Deserialize)]
+pub struct ProxyBatchPayload {
+  pub manifest: Box<RawValue>,
+  pub entries:  Vec<ProxyBatchEntry>,
+}
+
+/// Per-entry outcome of a batch notarization, in entry order. A failed fetch
+/// or validation surfaces here as an error string instead of failing the
+/// whole batch.
+#[derive(Serialize)]
+#[serde(rename_all = "lowercase")]
+pub enum ProxyBatchResult {
+  Proof(TeeProof),
+  Error(String),
 }
 
 pub async fn proxy(
   query: Query<NotarizeQuery>,
   State(state): State<Arc<SharedState>>,
-  extract::Json(payload): extract::Json<web_prover_client::ProxyConfig>,
-) -> Result<Json<TeeProof>, NotaryServerError> {
+  headers: HeaderMap,
+  extract::Json(payload): extract::Json<RawProxyConfig>,
+) -> Result<axum::response::Response, NotaryServerError> {
   let session_id = query.session_id;
 
   info!("Starting proxy with ID: {}", session_id);
 
-  let client = reqwest::Client::builder().timeout(Duration::from_secs(30)).build().unwrap();
-  let method: reqwest::Method = payload.target_method.parse().unwrap();
+  let compiled = state.manifest_registry.get_or_compile_raw(&payload.manifest)?;
+  let tee_proof = notarize_target(
+    state,
+    compiled,
+    ProxyBatchEntry {
+      target_method:  payload.target_method,
+      target_url:     payload.target_url,
+      target_headers: payload.target_headers,
+      target_body:    payload.target_body,
+    },
+    query.skip_cache,
+    query.priority.unwrap_or(Priority::Interactive),
+  )
+  .await?;
+
+  if wants_compact_proof(&headers) {
+    let bytes = tee_proof.to_compact_bytes()?;
+    return Ok(octet_stream_response(bytes));
+  }
+  Ok(Json(tee_proof).into_response())
+}
+
+pub async fn proxy_batch(
+  query: Query<NotarizeQuery>,
+  State(state): State<Arc<SharedState>>,
+  headers: HeaderMap,
+  extract::Json(payload): extract::Json<ProxyBatchPayload>,
+) -> Result<axum::response::Response, NotaryServerError> {
+  let session_id = query.session_id;
+  let ProxyBatchPayload { manifest, entries } = payload;
+
+  info!("Starting batch proxy with ID: {}, entries: {}", session_id, entries.len());
+
+  // Compile (and cache) the shared manifest once up front, so an invalid
+  // manifest fails the batch before any upstream traffic is sent and every
+  // entry reuses the compiled form.
+  let compiled = state.manifest_registry.get_or_compile_raw(&manifest)?;
+
+  let skip_cache = query.skip_cache;
+  let priority = query.priority.unwrap_or(Priority::Batch);
+  let results = futures::future::join_all(entries.into_iter().map(|entry| {
+    let state = state.clone();
+    let compiled = compiled.clone();
+    async move {
+      match notarize_target(state, compiled, entry, skip_cache, priority).await {
+        Ok(proof) => ProxyBatchResult::Proof(proof),
+        Err(err) => ProxyBatchResult::Error(err.to_string()),
+      }
+    }
+  }))
+  .await;
+
+  if wants_compact_proof(&headers) {
+    let bytes = encode_compact_batch(&results)?;
+    return Ok(octet_stream_response(bytes));
+  }
+  Ok(Json(results).into_response())
+}
+
+/// Returns true when the client asked for the compact binary proof encoding
+/// instead of JSON
+fn wants_compact_proof(headers: &HeaderMap) -> bool {
+  headers
+    .get(header::ACCEPT)
+    .and_then(|value| value.to_str().ok())
+    .is_some_and(|accept| accept.contains("application/octet-stream"))
+}
+
+fn octet_stream_response(bytes: Vec<u8>) -> axum::response::Response {
+  ([(header::CONTENT_TYPE, "application/octet-stream")], bytes).into_response()
+}
+
+/// Encodes batch results as a u16 entry count followed by, per entry, a tag
+/// byte (0 = proof, 1 = error) and a u16-length-prefixed payload: the compact
+/// proof bytes or the UTF-8 error string.
+fn encode_compact_batch(results: &[ProxyBatchResult]) -> Result<Vec<u8>, NotaryServerError> {
+  let count = u16::try_from(results.len())
+    .map_err(|_| ProxyError::InvalidRequest("Batch larger than 65535 entries".to_string()))?;
+  let mut out = Vec::with_capacity(results.len() * 300);
+  out.extend_from_slice(&count.to_be_bytes());
+  for result in results {
+    let (tag, payload) = match result {
+      ProxyBatchResult::Proof(proof) => (0u8, proof.to_compact_bytes()?),
+      ProxyBatchResult::Error(message) => (1u8, message.clone().into_bytes()),
+    };
+    out.push(tag);
+    let len = u16::try_from(payload.len())
+      .map_err(|_| ProxyError::InvalidRequest("Batch entry exceeds 65535 bytes".to_string()))?;
+    out.extend_from_slice(&len.to_be_bytes());
+    out.extend_from_slice(&payload);
+  }
+  Ok(out)
+}
 
-  let mut request_builder: reqwest::RequestBuilder = client.request(method, payload.target_url);
-  for (key, value) in payload.target_headers {
+/// Fetches one upstream target and notarizes the exchange against `manifest`.
+/// Shared by the single-shot and batch proxy handlers.
+///
+/// When the manifest declares `cache_ttl_seconds`, an identical (manifest,
+/// target request) pair within the freshness window is served straight from
+/// the proof cache — no upstream fetch, extraction, or signature. Clients can
+/// force a fresh proof with `?skip_cache=true`.
+async fn notarize_target(
+  state: Arc<SharedState>,
+  compiled: Arc<CompiledManifest>,
+  entry: ProxyBatchEntry,
+  skip_cache: bool,
+  priority: Priority,
+) -> Result<TeeProof, NotaryServerError> {
+  let origin =
+    reqwest::Url::parse(&entry.target_url).ok().and_then(|url| url.host_str().map(str::to_string));
+  // Warm the DNS cache for the target host while the rest of the pipeline
+  // runs; a no-op whenever the resolver already holds a fresh entry
+  if let Some(host) = &origin {
+    state.dns_resolver.prefetch(host);
+  }
+  let cache_key = compiled
+    .manifest()
+    .cache_ttl_seconds
+    .map(|ttl| (cache::proof_cache_key(&compiled.digest(), &entry), Duration::from_secs(ttl)));
+
+  if !skip_cache {
+    if let Some((key, _)) = &cache_key {
+      if let Some(proof) = state.proof_cache.get(key) {
+        debug!("Serving proof from cache");
+        state.metrics.proof_cache_hits_total.fetch_add(1, Ordering::Relaxed);
+        return Ok(proof);
+      }
+    }
+  }
+
+  // Admission comes after the cache check so cached proofs are served without
+  // consuming an upstream slot; the permit is held until the proof is built
+  let _permit = state.admission.admit(origin.as_deref().unwrap_or(""), priority).await?;
+
+  let metrics_state = state.clone();
+  let result = fetch_and_prove(state, &compiled, entry).await;
+  let counter = match &result {
+    Ok(_) => &metrics_state.metrics.proofs_total,
+    Err(_) => &metrics_state.metrics.proof_errors_total,
+  };
+  counter.fetch_add(1, Ordering::Relaxed);
+
+  if let (Ok(proof), Some((key, ttl))) = (&result, cache_key) {
+    metrics_state.proof_cache.insert(key, proof.clone(), ttl);
+  }
+  result
+}
+
+async fn fetch_and_prove(
+  state: Arc<SharedState>,
+  compiled: &CompiledManifest,
+  entry: ProxyBatchEntry,
+) -> Result<TeeProof, NotaryServerError> {
+  let method: reqwest::Method = entry
+    .target_method
+    .parse()
+    .map_err(|_| ProxyError::InvalidRequest(format!("Invalid method '{}'", entry.target_method)))?;
+
+  let mut request_builder: reqwest::RequestBuilder =
+    state.upstream_client.request(method, entry.target_url);
+  for (key, value) in entry.target_headers {
     request_builder = request_builder.header(key, value);
   }
-  if !payload.target_body.is_empty() {
-    request_builder = request_builder.body(payload.target_body.clone());
+  if !entry.target_body.is_empty() {
+    request_builder = request_builder.body(entry.target_body);
   }
 
-  let reqwest_request = request_builder.try_clone().unwrap().build().unwrap();
-  let reqwest_response = request_builder.send().await.unwrap();
+  let reqwest_request =
+    request_builder.try_clone().unwrap().build().map_err(ProxyError::Reqwest)?;
+
+  let fetch_started = Instant::now();
+  let reqwest_response = request_builder.send().await.map_err(ProxyError::Reqwest)?;
+  state.metrics.upstream_fetch_seconds.observe_since(fetch_started);
 
   let request = from_reqwest_request(&reqwest_request);
   // debug!("{:?}", request);
 
-  let response = from_reqwest_response(reqwest_response).await?;
-  // debug!("{:?}", response);
+  // When the manifest opts in, stop reading the upstream body once every
+  // extractor is satisfied by the prefix received so far
+  let body_config = &compiled.manifest().response.body.0;
+  let early_exit_config = body_config.early_exit.then_some(body_config);
 
-  let tee_proof = create_tee_proof(&payload.manifest, &request, &response, State(state))?;
+  let body_started = Instant::now();
+  let response =
+    from_reqwest_response(reqwest_response, state.max_upstream_body, early_exit_config).await?;
+  state.metrics.upstream_body_seconds.observe_since(body_started);
+  let body_len = response.notary_response_body.body.as_ref().map_or(0, Vec::len);
+  state.metrics.upstream_body_bytes.observe(body_len as f64);
+  // debug!("{:?}", response);
 
-  Ok(Json(tee_proof))
+  create_tee_proof(compiled, &request, &response, State(state)).await
 }
 
 // TODO: This, similarly to other from_* methods, should be a trait
 // Requires adding reqwest to proofs crate
-async fn from_reqwest_response(response: Response) -> Result<NotaryResponse, NotaryServerError> {
+async fn from_reqwest_response(
+  response: Response,
+  max_body_bytes: usize,
+  early_exit_config: Option<&ExtractorConfig>,
+) -> Result<NotaryResponse, NotaryServerError> {
   let status = response.status().as_u16().to_string();
   let version = format!("{:?}", response.version());
   let message = response.status().canonical_reason().unwrap_or("").to_string();
@@ -74,16 +303,7 @@ async fn from_reqwest_response(response: Response) -> Result<NotaryResponse, Not
     .iter()
     .map(|(k, v)| (capitalize_header(k.as_ref()), v.to_str().unwrap_or("").to_string()))
     .collect();
-  let body = response
-    .bytes()
-    .await
-    .map_err(|_| {
-      NotaryServerError::ProxyError(ProxyError::Io(std::io::Error::new(
-        std::io::ErrorKind::Other,
-        "Failed to read response body",
-      )))
-    })?
-    .to_vec();
+  let body = read_body_bounded(response, max_body_bytes, early_exit_config).await?;
   Ok(NotaryResponse {
     response:             ManifestResponse {
       status,
@@ -98,6 +318,70 @@ async fn from_reqwest_response(response: Response) -> Result<NotaryResponse, Not
   })
 }
 
+/// How many new body bytes to buffer before the first early-exit extraction
+/// probe. Each probe runs a full extraction over the buffered prefix, so the
+/// interval doubles after every unsatisfied probe — total probe work stays
+/// linear in the body size instead of quadratic when extractors are
+/// satisfied late or never.
+const EARLY_EXIT_PROBE_INTERVAL: usize = 64 * 1024;
+
+/// Streams the upstream body chunk-by-chunk as it arrives from the socket
+/// instead of buffering it with `bytes()` up front, enforcing a per-session
+/// memory cap so a handful of oversized targets cannot blow out notary RSS.
+///
+/// With `early_exit_config` set (manifest opt-in), the buffered prefix is
+/// probed periodically and reading stops as soon as every extractor is
+/// satisfied, so multi-megabyte pages whose data sits in the first few
+/// kilobytes are not downloaded in full.
+async fn read_body_bounded(
+  mut response: Response,
+  max_body_bytes: usize,
+  early_exit_config: Option<&ExtractorConfig>,
+) -> Result<Vec<u8>, NotaryServerError> {
+  let io_error = |message: &str| {
+    NotaryServerError::ProxyError(ProxyError::Io(std::io::Error::new(
+      std::io::ErrorKind::Other,
+      message,
+    )))
+  };
+
+  // Reject early when the upstream declares a body larger than the cap
+  if let Some(length) = response.content_length() {
+    if length as usize > max_body_bytes {
+      return Err(io_error("Upstream response body exceeds the configured limit"));
+    }
+  }
+
+  let mut body = Vec::with_capacity(response.content_length().unwrap_or(0) as usize);
+  let mut last_probe_len = 0usize;
+  let mut probe_interval = EARLY_EXIT_PROBE_INTERVAL;
+  while let Some(chunk) =
+    response.chunk().await.map_err(|_| io_error("Failed to read response body"))?
+  {
+    if body.len() + chunk.len() > max_body_bytes {
+      return Err(io_error("Upstream response body exceeds the configured limit"));
+    }
+    body.extend_from_slice(&chunk);
+
+    if let Some(config) = early_exit_config {
+      if body.len() - last_probe_len >= probe_interval {
+        last_probe_len = body.len();
+        // A prefix that fails to parse simply isn't complete yet; keep reading
+        let satisfied = config
+          .extract_and_validate(&body)
+          .map(|result| config.is_satisfied_by(&result))
+          .unwrap_or(false);
+        if satisfied {
+          debug!("Early exit: extractors satisfied after {} body bytes", body.len());
+          break;
+        }
+        probe_interval = probe_interval.saturating_mul(2);
+      }
+    }
+  }
+  Ok(body)
+}
+
 fn from_reqwest_request(request: &Request) -> ManifestRequest {
   let method = request.method().to_string();
   let url = request.url().to_string();
@@ -114,33 +398,57 @@ fn from_reqwest_request(request: &Request) -> ManifestRequest {
 // TODO: Not sure how to normalize data from different formats/protocols into a canonical
 //  `ManifestRequest` and `ManifestResponse`, so for now using this helper as a workaround
 fn capitalize_header(header: &str) -> String {
-  header
-    .split('-')
-    .map(|part| {
-      let mut chars = part.chars();
-      chars.next().map(|c| c.to_ascii_uppercase()).into_iter().chain(chars).collect::<String>()
-    })
-    .collect::<Vec<_>>()
-    .join("-")
-}
-
-pub fn create_tee_proof(
-  manifest: &Manifest,
+  let mut capitalized = String::with_capacity(header.len());
+  let mut at_part_start = true;
+  for c in header.chars() {
+    if at_part_start {
+      capitalized.push(c.to_ascii_uppercase());
+    } else {
+      capitalized.push(c);
+    }
+    at_part_start = c == '-';
+  }
+  capitalized
+}
+
+pub async fn create_tee_proof(
+  compiled: &CompiledManifest,
   request: &ManifestRequest,
   response: &NotaryResponse,
   State(state): State<Arc<SharedState>>,
 ) -> Result<TeeProof, NotaryServerError> {
-  let validation_result = validate_notarization_legal(manifest, request, response)?;
+  let extraction_started = Instant::now();
+  let validation_result = validate_notarization_legal(&compiled, request, response)?;
+  let extraction_histogram = match compiled.manifest().response.body.0.format {
+    DataFormat::Json => &state.metrics.extraction_json_seconds,
+    DataFormat::Html => &state.metrics.extraction_html_seconds,
+  };
+  extraction_histogram.observe_since(extraction_started);
+  if !validation_result.is_success() {
+    state
+      .metrics
+      .validation_failures_total
+      .fetch_add(validation_result.errors().len() as u64, Ordering::Relaxed);
+  }
 
-  let manifest_hash = manifest.to_keccak_digest()?;
+  let manifest_hash = compiled.digest();
+  let digest_started = Instant::now();
   let extraction_hash = validation_result.extraction_keccak_digest()?;
-  let proof_value_hash = keccak_digest(&[manifest_hash, extraction_hash].concat());
+  let mut proof_value_hasher = IncrementalKeccak::new();
+  proof_value_hasher.update(&manifest_hash);
+  proof_value_hasher.update(&extraction_hash);
+  let proof_value_hash = proof_value_hasher.finalize();
+  state.metrics.digest_seconds.observe_since(digest_started);
 
-  let to_sign = VerifyOutput {
-    value:    format!("0x{}", hex::encode(proof_value_hash)),
-    manifest: manifest.clone(),
+  let to_sign =
+    VerifyOutput { value: format!("0x{}", hex::encode(proof_value_hash)), manifest_hash };
+  let sign_started = Instant::now();
+  let metrics_state = state.clone();
+  let signature = match &metrics_state.signature_aggregator {
+    Some(aggregator) => aggregator.sign(to_sign).await?,
+    None => sign_verification(to_sign, State(state))?,
   };
-  let signature = sign_verification(to_sign, State(state))?;
+  metrics_state.metrics.sign_seconds.observe_since(sign_started);
   let data = TeeProofData { manifest_hash: manifest_hash.to_vec() };
 
   Ok(TeeProof { data, signature })
@@ -149,12 +457,12 @@ pub fn create_tee_proof(
 /// Check if `manifest`, `request`, and `response` all fulfill requirements necessary for
 /// a proof to be created
 fn validate_notarization_legal(
-  manifest: &Manifest,
+  compiled: &CompiledManifest,
   request: &ManifestRequest,
   response: &NotaryResponse,
 ) -> Result<ManifestValidationResult, NotaryServerError> {
   debug!("Validating manifest");
-  let result = manifest.validate_with(request, response)?;
+  let result = compiled.validate_with(request, response)?;
   if !result.is_success() {
     info!("Manifest validation failed: {:?}", result.errors());
   }
@@ -0,0 +1,109 @@
+use std::{
+  collections::HashMap,
+  sync::{Arc, RwLock},
+};
+
+use serde_json::value::RawValue;
+use web_prover_core::{
+  hash::keccak_digest,
+  manifest::{CompiledManifest, Manifest},
+};
+
+use crate::error::NotaryServerError;
+
+/// Safety valve against unbounded growth: the fleet serves a small, fixed
+/// working set of manifests, so hitting this limit means something is feeding
+/// us garbage and dropping the cache is the cheapest way to recover.
+const MAX_COMPILED_MANIFESTS: usize = 1024;
+
+/// A registry of compiled manifests keyed by their keccak digest.
+///
+/// The notary serves the same handful of manifests thousands of times per
+/// minute; compiling each manifest once on first sight and caching the
+/// compiled form lets every subsequent request skip static validation and
+/// reuse the precomputed digest.
+#[derive(Default)]
+pub struct ManifestRegistry {
+  compiled:  RwLock<HashMap<[u8; 32], Arc<CompiledManifest>>>,
+  /// Secondary index keyed by the keccak digest of the manifest's raw JSON
+  /// bytes as they appeared in the request body. A hit here resolves the
+  /// compiled manifest without deserializing the manifest at all; the
+  /// canonical index above still deduplicates manifests whose raw encodings
+  /// differ only in whitespace or field order.
+  raw_index: RwLock<HashMap<[u8; 32], Arc<CompiledManifest>>>,
+}
+
+impl ManifestRegistry {
+  /// Returns the compiled form of `manifest`, compiling and caching it on
+  /// first sight.
+  pub fn get_or_compile(
+    &self,
+    manifest: &Manifest,
+  ) -> Result<Arc<CompiledManifest>, NotaryServerError> {
+    let digest = manifest.to_keccak_digest()?;
+
+    if let Some(compiled) = self.compiled.read().unwrap().get(&digest) {
+      return Ok(compiled.clone());
+    }
+
+    let compiled = Arc::new(manifest.clone().compile()?);
+    let mut cache = self.compiled.write().unwrap();
+    if cache.len() >= MAX_COMPILED_MANIFESTS {
+      cache.clear();
+    }
+    Ok(cache.entry(digest).or_insert(compiled).clone())
+  }
+
+  /// Returns the compiled form of the manifest serialized in `raw`,
+  /// deserializing and compiling it only on first sight of these exact bytes.
+  ///
+  /// The proxy working set is a small, fixed set of manifests whose clients
+  /// send byte-identical JSON on every request, so after warm-up this is a
+  /// digest plus a map lookup — no per-request manifest parse and none of its
+  /// per-field allocations.
+  pub fn get_or_compile_raw(
+    &self,
+    raw: &RawValue,
+  ) -> Result<Arc<CompiledManifest>, NotaryServerError> {
+    let raw_digest = keccak_digest(raw.get().as_bytes());
+
+    if let Some(compiled) = self.raw_index.read().unwrap().get(&raw_digest) {
+      return Ok(compiled.clone());
+    }
+
+    let manifest: Manifest = serde_json::from_str(raw.get())?;
+    let compiled = self.get_or_compile(&manifest)?;
+    let mut index = self.raw_index.write().unwrap();
+    if index.len() >= MAX_COMPILED_MANIFESTS {
+      index.clear();
+    }
+    Ok(index.entry(raw_digest).or_insert(compiled).clone())
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  const PROXY_FIXTURE: &str = include_str!("../../fixture/client.json.proxy.json");
+
+  #[test]
+  fn test_raw_index_resolves_repeated_bytes_to_one_compiled_manifest() {
+    let mut fixture: serde_json::Value = serde_json::from_str(PROXY_FIXTURE).unwrap();
+    // The checked-in fixture predates manifest version 2
+    fixture["manifest"]["manifestVersion"] = serde_json::json!("2");
+    let raw = serde_json::value::to_raw_value(&fixture["manifest"]).unwrap();
+
+    let registry = ManifestRegistry::default();
+    let first = registry.get_or_compile_raw(&raw).unwrap();
+    let second = registry.get_or_compile_raw(&raw).unwrap();
+    assert!(Arc::ptr_eq(&first, &second));
+
+    // A different raw encoding of the same manifest misses the raw index but
+    // deduplicates through the canonical digest
+    let pretty = serde_json::to_string_pretty(&fixture["manifest"]).unwrap();
+    let raw_pretty: Box<RawValue> = serde_json::from_str(&pretty).unwrap();
+    let third = registry.get_or_compile_raw(&raw_pretty).unwrap();
+    assert!(Arc::ptr_eq(&first, &third));
+  }
+}
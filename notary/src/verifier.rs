@@ -1,9 +1,12 @@
-use std::sync::Arc;
+use std::{sync::Arc, time::Duration};
 
 use alloy_primitives::utils::keccak256;
+use k256::ecdsa::{SigningKey, VerifyingKey};
 use rs_merkle::{Hasher, MerkleTree};
 use serde::{Deserialize, Serialize};
-use web_prover_core::{manifest::Manifest, proof::SignedVerificationReply};
+use tokio::sync::{mpsc, oneshot};
+use tracing::debug;
+use web_prover_core::proof::SignedVerificationReply;
 
 use crate::{error::NotaryServerError, SharedState, State};
 
@@ -18,39 +21,48 @@ impl Hasher for KeccakHasher {
 
 #[derive(Serialize, Deserialize, Debug, Clone)]
 pub struct VerifyOutput<T: AsRef<[u8]>> {
-  pub value:    T,
-  pub manifest: Manifest,
+  pub value:         T,
+  /// Keccak digest of the manifest, as computed by
+  /// [`web_prover_core::manifest::CompiledManifest::digest`]. Taking the
+  /// precomputed digest keeps the signing path free of a redundant manifest
+  /// serialization per proof.
+  pub manifest_hash: [u8; 32],
 }
 
-pub fn sign_verification<T: AsRef<[u8]>>(
-  query: VerifyOutput<T>,
-  State(state): State<Arc<SharedState>>,
-) -> Result<SignedVerificationReply, NotaryServerError> {
-  // TODO check OSCP and CT (maybe)
-  // TODO check target_name matches SNI and/or cert name (let's discuss)
-
-  let leaf_hashes = vec![
-    KeccakHasher::hash(query.value.as_ref()),
-    KeccakHasher::hash(serde_json::to_string(&query.manifest)?.as_bytes()),
-  ];
+/// Hashes a proof's (value, manifest) pair into its two leaves and the root
+/// of the two-leaf tree over them. In individual signing mode the root is
+/// signed directly; in aggregated mode it becomes one leaf of the batch tree.
+fn proof_leaves<T: AsRef<[u8]>>(query: &VerifyOutput<T>) -> (Vec<[u8; 32]>, [u8; 32]) {
+  let leaf_hashes = vec![KeccakHasher::hash(query.value.as_ref()), query.manifest_hash];
   let merkle_tree = MerkleTree::<KeccakHasher>::from_leaves(&leaf_hashes);
   let merkle_root = merkle_tree.root().unwrap();
+  (leaf_hashes, merkle_root)
+}
 
+/// Signs `merkle_root` with the notary key and assembles the reply fields
+/// shared by the individual and aggregated signing paths.
+fn sign_merkle_root(
+  signing_key: &SigningKey,
+  verifying_key: &VerifyingKey,
+  signer_address: &alloy_primitives::Address,
+  merkle_root: [u8; 32],
+  merkle_leaves: Vec<String>,
+) -> SignedVerificationReply {
   // need secp256k1 here for Solidity
-  let (signature, recover_id) =
-    state.notary_signing_key.sign_prehash_recoverable(&merkle_root).unwrap();
-
-  let signer_address =
-    alloy_primitives::Address::from_public_key(state.notary_signing_key.verifying_key());
-
-  let verifying_key =
-    k256::ecdsa::VerifyingKey::recover_from_prehash(&merkle_root.clone(), &signature, recover_id)
-      .unwrap();
-
-  assert_eq!(
-    state.notary_signing_key.verifying_key().to_sec1_bytes(),
-    verifying_key.to_sec1_bytes()
-  );
+  let (signature, recover_id) = signing_key.sign_prehash_recoverable(&merkle_root).unwrap();
+
+  // Self-check: recover the public key from the fresh signature and compare
+  // it against the configured signer. A full recovery per proof is too
+  // expensive for the hot path, so it only runs in debug builds.
+  #[cfg(debug_assertions)]
+  {
+    let recovered =
+      k256::ecdsa::VerifyingKey::recover_from_prehash(&merkle_root, &signature, recover_id)
+        .unwrap();
+    assert_eq!(verifying_key.to_sec1_bytes(), recovered.to_sec1_bytes());
+  }
+  #[cfg(not(debug_assertions))]
+  let _ = verifying_key;
 
   // TODO is this right? we need lower form S for sure though
   let s = if signature.normalize_s().is_some() {
@@ -59,21 +71,185 @@ pub fn sign_verification<T: AsRef<[u8]>>(
     hex::encode(signature.s().to_bytes())
   };
 
-  let response = SignedVerificationReply {
-    merkle_leaves: vec![
-      "0x".to_string() + &hex::encode(leaf_hashes[0]),
-      "0x".to_string() + &hex::encode(leaf_hashes[1]),
-    ],
-    digest:        "0x".to_string() + &hex::encode(merkle_root),
-    signature:     "0x".to_string() + &hex::encode(signature.to_der().as_bytes()),
-    signature_r:   "0x".to_string() + &hex::encode(signature.r().to_bytes()),
-    signature_s:   "0x".to_string() + &s,
+  SignedVerificationReply {
+    merkle_leaves,
+    digest: "0x".to_string() + &hex::encode(merkle_root),
+    signature: "0x".to_string() + &hex::encode(signature.to_der().as_bytes()),
+    signature_r: "0x".to_string() + &hex::encode(signature.r().to_bytes()),
+    signature_s: "0x".to_string() + &s,
 
     // the good old +27
     // https://docs.openzeppelin.com/contracts/4.x/api/utils#ECDSA-tryRecover-bytes32-bytes-
     signature_v: recover_id.to_byte() + 27,
-    signer:      "0x".to_string() + &hex::encode(signer_address),
-  };
+    signer: "0x".to_string() + &hex::encode(signer_address),
+    merkle_path: None,
+    leaf_index: None,
+  }
+}
+
+pub fn sign_verification<T: AsRef<[u8]>>(
+  query: VerifyOutput<T>,
+  State(state): State<Arc<SharedState>>,
+) -> Result<SignedVerificationReply, NotaryServerError> {
+  // TODO check OSCP and CT (maybe)
+  // TODO check target_name matches SNI and/or cert name (let's discuss)
+
+  let (leaf_hashes, merkle_root) = proof_leaves(&query);
+  Ok(sign_merkle_root(
+    &state.notary_signing_key,
+    &state.notary_verifying_key,
+    &state.notary_signer_address,
+    merkle_root,
+    vec![
+      "0x".to_string() + &hex::encode(leaf_hashes[0]),
+      "0x".to_string() + &hex::encode(leaf_hashes[1]),
+    ],
+  ))
+}
+
+/// One proof waiting for the aggregate signature: its two-leaf root (the
+/// batch-tree leaf), the hex leaves for the reply, and the channel the signed
+/// reply is delivered on.
+struct AggregationJob {
+  leaf_root:     [u8; 32],
+  merkle_leaves: Vec<String>,
+  reply:         oneshot::Sender<SignedVerificationReply>,
+}
+
+/// Batches proofs under a single secp256k1 signature.
+///
+/// ECDSA signing is ~30% of notary CPU at peak, one signature per proof.
+/// The aggregator accumulates the per-proof roots submitted within a window
+/// (bounded by batch size and by time), builds one Merkle tree over them,
+/// and signs only the aggregate root; every proof in the batch gets the same
+/// signature plus its inclusion path and leaf index, so the on-chain verifier
+/// checks one signature amortized across N proofs.
+pub struct SignatureAggregator {
+  jobs: mpsc::Sender<AggregationJob>,
+}
+
+impl SignatureAggregator {
+  /// Spawns the aggregation worker. `max_batch` bounds how many proofs share
+  /// one signature, `window` bounds how long the first proof in a batch waits
+  /// for company.
+  pub fn spawn(
+    signing_key: SigningKey,
+    verifying_key: VerifyingKey,
+    signer_address: alloy_primitives::Address,
+    max_batch: usize,
+    window: Duration,
+  ) -> Self {
+    let (jobs, mut queue) = mpsc::channel::<AggregationJob>(max_batch * 4);
+
+    tokio::spawn(async move {
+      while let Some(first) = queue.recv().await {
+        let mut batch = vec![first];
+        let deadline = tokio::time::sleep(window);
+        tokio::pin!(deadline);
+        while batch.len() < max_batch {
+          tokio::select! {
+            _ = &mut deadline => break,
+            job = queue.recv() => match job {
+              Some(job) => batch.push(job),
+              None => break,
+            },
+          }
+        }
+
+        let leaves: Vec<[u8; 32]> = batch.iter().map(|job| job.leaf_root).collect();
+        let tree = MerkleTree::<KeccakHasher>::from_leaves(&leaves);
+        let root = tree.root().unwrap();
+        let signed = sign_merkle_root(&signing_key, &verifying_key, &signer_address, root, vec![]);
+        debug!("Signed aggregate root over {} proofs", batch.len());
+
+        for (index, job) in batch.into_iter().enumerate() {
+          let path =
+            tree.proof(&[index]).proof_hashes().iter().map(hex::encode).collect::<Vec<_>>();
+          let mut reply = signed.clone();
+          reply.merkle_leaves = job.merkle_leaves;
+          reply.merkle_path = Some(path.into_iter().map(|node| "0x".to_string() + &node).collect());
+          reply.leaf_index = Some(index as u32);
+          // The waiter may have gone away (client disconnect); nothing to do
+          let _ = job.reply.send(reply);
+        }
+      }
+    });
+
+    Self { jobs }
+  }
+
+  /// Submits one proof for aggregated signing and waits for the batch it
+  /// lands in to be signed.
+  pub async fn sign<T: AsRef<[u8]>>(
+    &self,
+    query: VerifyOutput<T>,
+  ) -> Result<SignedVerificationReply, NotaryServerError> {
+    let (leaf_hashes, leaf_root) = proof_leaves(&query);
+    let (reply_tx, reply_rx) = oneshot::channel();
+    let job = AggregationJob {
+      leaf_root,
+      merkle_leaves: vec![
+        "0x".to_string() + &hex::encode(leaf_hashes[0]),
+        "0x".to_string() + &hex::encode(leaf_hashes[1]),
+      ],
+      reply: reply_tx,
+    };
+    self
+      .jobs
+      .send(job)
+      .await
+      .map_err(|_| NotaryServerError::ServerConfigError("signature aggregator stopped".into()))?;
+    reply_rx
+      .await
+      .map_err(|_| NotaryServerError::ServerConfigError("signature aggregator stopped".into()))
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use rs_merkle::MerkleProof;
+
+  use super::*;
+
+  fn decode_hash(hex_str: &str) -> [u8; 32] {
+    hex::decode(hex_str.strip_prefix("0x").unwrap()).unwrap().try_into().unwrap()
+  }
+
+  #[tokio::test]
+  async fn test_aggregator_amortizes_one_signature_across_batch() {
+    let signing_key = crate::ephemeral_notary_signing_key();
+    let verifying_key = *signing_key.verifying_key();
+    let signer_address = alloy_primitives::Address::from_public_key(&verifying_key);
+    let aggregator = SignatureAggregator::spawn(
+      signing_key,
+      verifying_key,
+      signer_address,
+      3,
+      Duration::from_millis(200),
+    );
+
+    let queries: Vec<_> = (0..3u8)
+      .map(|i| VerifyOutput { value: format!("0x{:02x}", i), manifest_hash: [i; 32] })
+      .collect();
+    let replies = futures::future::join_all(queries.iter().cloned().map(|q| aggregator.sign(q)))
+      .await
+      .into_iter()
+      .collect::<Result<Vec<_>, _>>()
+      .unwrap();
 
-  Ok(response)
+    // All three proofs share the same aggregate root and signature
+    assert!(replies.iter().all(|r| r.digest == replies[0].digest));
+    assert!(replies.iter().all(|r| r.signature == replies[0].signature));
+
+    // Each reply's inclusion path proves its leaf against the signed root
+    let root = decode_hash(&replies[0].digest);
+    for (query, reply) in queries.iter().zip(&replies) {
+      let (_, leaf_root) = proof_leaves(query);
+      let index = reply.leaf_index.unwrap() as usize;
+      let path: Vec<[u8; 32]> =
+        reply.merkle_path.as_ref().unwrap().iter().map(|node| decode_hash(node)).collect();
+      let proof = MerkleProof::<KeccakHasher>::new(path);
+      assert!(proof.verify(root, &[index], &[leaf_root], replies.len()));
+    }
+  }
 }
@@ -0,0 +1,157 @@
+//! Load-test harness for the notary.
+//!
+//! Spawns the `web-prover-notary` binary the same way the integration test
+//! does, then drives it in-process through [`web_prover_client::WebProverClient`]
+//! at a configurable concurrency for a fixed duration, and reports proofs/sec,
+//! latency percentiles, and notary RSS. Run it with:
+//!
+//! ```text
+//! cargo run -p web-prover-tests --release -- bench \
+//!   --concurrency 64 --duration 30 [--config fixture/client.json.proxy.json]...
+//! ```
+
+use std::{
+  sync::Arc,
+  time::{Duration, Instant},
+};
+
+use web_prover_client::{config::Config, WebProverClient};
+
+use crate::{spawn_notary, workspace_root, CLIENT_CONFIG_PATHS};
+
+/// How the bench run is shaped; defaults mirror the integration-test fixtures
+pub struct BenchOptions {
+  /// Client config files (JSON, same shape as `fixture/client.*.json`); each
+  /// worker replays one of them round-robin
+  pub config_paths: Vec<String>,
+  /// Number of concurrent proving sessions
+  pub concurrency:  usize,
+  /// How long to keep issuing requests
+  pub duration:     Duration,
+}
+
+impl Default for BenchOptions {
+  fn default() -> Self {
+    Self {
+      config_paths: CLIENT_CONFIG_PATHS.iter().map(|p| p.to_string()).collect(),
+      concurrency:  32,
+      duration:     Duration::from_secs(30),
+    }
+  }
+}
+
+/// Latencies and error count collected by one worker
+#[derive(Default)]
+struct WorkerStats {
+  latencies: Vec<Duration>,
+  errors:    u64,
+}
+
+/// Runs the load test end to end: spawn notary, drive load, print the report.
+pub async fn run(options: BenchOptions) {
+  let workspace_root = workspace_root();
+  println!("Workspace root: {:?}", workspace_root);
+
+  let mut configs = Vec::new();
+  for path in &options.config_paths {
+    let raw = std::fs::read_to_string(workspace_root.join(path))
+      .unwrap_or_else(|e| panic!("failed to read client config {}: {}", path, e));
+    let mut config: Config = serde_json::from_str(&raw)
+      .unwrap_or_else(|e| panic!("failed to parse client config {}: {}", path, e));
+    config.set_session_id();
+    configs.push(config);
+  }
+  assert!(!configs.is_empty(), "no client configs given");
+
+  let mut notary = spawn_notary(&workspace_root).await;
+  let notary_pid = notary.id();
+
+  // One persistent client per config so workers reuse warm notary connections
+  let clients: Vec<Arc<WebProverClient>> = configs
+    .into_iter()
+    .map(|config| Arc::new(WebProverClient::new(config).expect("failed to build client")))
+    .collect();
+
+  // Track peak notary RSS while the run is in flight
+  let peak_rss_kb = Arc::new(std::sync::atomic::AtomicU64::new(0));
+  let rss_tracker = {
+    let peak_rss_kb = peak_rss_kb.clone();
+    tokio::spawn(async move {
+      loop {
+        if let Some(rss) = process_rss_kb(notary_pid) {
+          peak_rss_kb.fetch_max(rss, std::sync::atomic::Ordering::Relaxed);
+        }
+        tokio::time::sleep(Duration::from_secs(1)).await;
+      }
+    })
+  };
+
+  let started = Instant::now();
+  let deadline = started + options.duration;
+  let mut workers = Vec::with_capacity(options.concurrency);
+  for worker_index in 0..options.concurrency {
+    let client = clients[worker_index % clients.len()].clone();
+    workers.push(tokio::spawn(async move {
+      let mut stats = WorkerStats::default();
+      while Instant::now() < deadline {
+        let request_started = Instant::now();
+        // Each call runs in its own task: `proxy` asserts on non-OK statuses,
+        // and a panic should count as one failed request, not kill the worker
+        let client = client.clone();
+        match tokio::spawn(async move { client.proxy().await }).await {
+          Ok(Ok(_)) => stats.latencies.push(request_started.elapsed()),
+          _ => stats.errors += 1,
+        }
+      }
+      stats
+    }));
+  }
+
+  let mut latencies = Vec::new();
+  let mut errors = 0u64;
+  for worker in workers {
+    let stats = worker.await.expect("bench worker panicked");
+    latencies.extend(stats.latencies);
+    errors += stats.errors;
+  }
+  let elapsed = started.elapsed();
+  rss_tracker.abort();
+
+  let final_rss_kb = process_rss_kb(notary_pid);
+  let _ = notary.kill();
+
+  latencies.sort_unstable();
+  let proofs = latencies.len() as u64;
+  println!("\n=== bench report ===");
+  println!("concurrency:    {}", options.concurrency);
+  println!("duration:       {:.1}s", elapsed.as_secs_f64());
+  println!("proofs:         {}", proofs);
+  println!("errors:         {}", errors);
+  println!("proofs/sec:     {:.2}", proofs as f64 / elapsed.as_secs_f64());
+  if !latencies.is_empty() {
+    println!("latency p50:    {:.1}ms", percentile(&latencies, 50.0).as_secs_f64() * 1000.0);
+    println!("latency p90:    {:.1}ms", percentile(&latencies, 90.0).as_secs_f64() * 1000.0);
+    println!("latency p99:    {:.1}ms", percentile(&latencies, 99.0).as_secs_f64() * 1000.0);
+  }
+  match (peak_rss_kb.load(std::sync::atomic::Ordering::Relaxed), final_rss_kb) {
+    (0, None) => println!("notary rss:     unavailable"),
+    (peak, final_kb) => println!(
+      "notary rss:     peak {:.1} MiB, final {}",
+      peak as f64 / 1024.0,
+      final_kb.map_or("unavailable".to_string(), |kb| format!("{:.1} MiB", kb as f64 / 1024.0))
+    ),
+  }
+}
+
+/// Nearest-rank percentile over sorted latencies
+fn percentile(sorted: &[Duration], p: f64) -> Duration {
+  let index = ((p / 100.0) * (sorted.len() - 1) as f64).round() as usize;
+  sorted[index]
+}
+
+/// Reads a process's resident set size in KiB from `/proc/<pid>/status`
+fn process_rss_kb(pid: u32) -> Option<u64> {
+  let status = std::fs::read_to_string(format!("/proc/{}/status", pid)).ok()?;
+  let line = status.lines().find(|line| line.starts_with("VmRSS:"))?;
+  line.split_whitespace().nth(1)?.parse().ok()
+}
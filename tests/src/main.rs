@@ -0,0 +1,37 @@
+use std::time::Duration;
+
+use web_prover_tests::bench::{self, BenchOptions};
+
+const USAGE: &str = "Usage: cargo run -p web-prover-tests --release -- bench [--config <path>]... \
+                     [--concurrency <n>] [--duration <secs>]";
+
+#[tokio::main]
+async fn main() {
+  let mut args = std::env::args().skip(1);
+  match args.next().as_deref() {
+    Some("bench") => {
+      let mut options = BenchOptions::default();
+      let mut config_paths = Vec::new();
+      while let Some(arg) = args.next() {
+        match arg.as_str() {
+          "--config" => config_paths.push(args.next().expect("--config requires a path")),
+          "--concurrency" =>
+            options.concurrency = args
+              .next()
+              .and_then(|v| v.parse().ok())
+              .expect("--concurrency requires a positive integer"),
+          "--duration" =>
+            options.duration = Duration::from_secs(
+              args.next().and_then(|v| v.parse().ok()).expect("--duration requires seconds"),
+            ),
+          other => panic!("unknown argument '{}'\n{}", other, USAGE),
+        }
+      }
+      if !config_paths.is_empty() {
+        options.config_paths = config_paths;
+      }
+      bench::run(options).await;
+    },
+    _ => eprintln!("{}", USAGE),
+  }
+}